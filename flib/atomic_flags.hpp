@@ -0,0 +1,291 @@
+// Copyright © 2024 Luka Arnecic.
+// See the LICENSE file at the top-level directory of this distribution.
+
+#pragma once
+
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <type_traits>
+
+#include <flib/flags.hpp>
+
+#if defined(_WIN32)
+#  define WIN32_LEAN_AND_MEAN
+#  include <windows.h>
+#  pragma comment(lib, "Synchronization.lib")
+#elif defined(__linux__)
+#  include <linux/futex.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#else
+#  include <condition_variable>
+#  include <mutex>
+#endif
+
+namespace flib
+{
+#pragma region API
+  // Lock-free set of enum flags (operators from flags.hpp), where every modification is single atomic read-modify-write
+  // operation, and waiting threads are blocked on futex (WaitOnAddress on Windows), which is signaled only when flags
+  // are set while there are waiting threads
+  template<class T>
+  class atomic_flags
+  {
+    static_assert(std::is_enum<T>::value, "Flags must be of enum type");
+
+  public:
+    using value_t = T;
+
+  public:
+    atomic_flags(void) noexcept = default;
+    explicit atomic_flags(T p_flags) noexcept;
+    atomic_flags(const atomic_flags&) = delete;
+    atomic_flags(atomic_flags&&) = delete;
+    ~atomic_flags(void) noexcept = default;
+    atomic_flags& operator=(const atomic_flags&) = delete;
+    atomic_flags& operator=(atomic_flags&&) = delete;
+    operator T(void) const noexcept;
+
+    // Method for clearing given flags.
+    //
+    // Parameters:
+    //   p_flags - flags to clear
+    // Returns:
+    //   Flags preceding modification
+    T clear(T p_flags) noexcept;
+
+    T load(void) const noexcept;
+
+    // Method for setting given flags.
+    //
+    // Parameters:
+    //   p_flags - flags to set
+    // Returns:
+    //   Flags preceding modification
+    T set(T p_flags) noexcept;
+
+    // Method for replacing all flags.
+    //
+    // Parameters:
+    //   p_flags - new flags
+    // Returns:
+    //   Flags preceding modification
+    T store(T p_flags) noexcept;
+
+    // Method for checking whether all given flags are set.
+    //
+    // Parameters:
+    //   p_flags - flags to check
+    // Returns:
+    //   True if all given flags are set
+    bool test(T p_flags) const noexcept;
+
+    // Method for setting given flags, while checking whether they were already set (e.g. for claiming one-time work).
+    //
+    // Parameters:
+    //   p_flags - flags to set
+    // Returns:
+    //   True if all given flags were already set
+    bool test_and_set(T p_flags) noexcept;
+
+    // Method for toggling given flags.
+    //
+    // Parameters:
+    //   p_flags - flags to toggle
+    // Returns:
+    //   Flags preceding modification
+    T toggle(T p_flags) noexcept;
+
+    // Method for blocking until all given flags are set.
+    //
+    // Parameters:
+    //   p_flags - flags to wait for
+    // Returns:
+    //   Flags satisfying condition
+    T wait_all(T p_flags) noexcept;
+
+    // Method for blocking until any of given flags is set.
+    //
+    // Parameters:
+    //   p_flags - flags to wait for
+    // Returns:
+    //   Flags satisfying condition
+    T wait_any(T p_flags) noexcept;
+
+  private:
+    void _notify(T p_previous, T p_current) noexcept;
+    template<class Predicate>
+    T _wait(Predicate p_predicate) noexcept;
+
+  private:
+    std::atomic<typename std::underlying_type<T>::type> m_flags{};
+    // Futex word, changed whenever waiting threads are signaled
+    std::atomic<uint32_t> m_epoch{};
+    std::atomic<uint32_t> m_waiters{};
+  };
+#pragma endregion
+
+#pragma region IMPLEMENTATION
+#if !defined(_WIN32) & !defined(__linux__)
+  inline std::mutex& _atomic_flags_mutex(void)
+  {
+    static std::mutex mutex;
+    return mutex;
+  }
+
+  inline std::condition_variable& _atomic_flags_condition(void)
+  {
+    static std::condition_variable condition;
+    return condition;
+  }
+#endif
+
+  // Blocks while futex word equals expected value (spurious returns are allowed)
+  inline void _atomic_flags_wait(std::atomic<uint32_t>& p_word, uint32_t p_expected) noexcept
+  {
+#if defined(_WIN32)
+    ::WaitOnAddress(&p_word, &p_expected, sizeof(p_expected), INFINITE);
+#elif defined(__linux__)
+    ::syscall(SYS_futex, &p_word, FUTEX_WAIT_PRIVATE, p_expected, nullptr, nullptr, 0);
+#else
+    std::unique_lock<std::mutex> guard(_atomic_flags_mutex());
+    _atomic_flags_condition().wait(guard, [&p_word, p_expected]()
+      {
+        return p_expected != p_word.load();
+      });
+#endif
+  }
+
+  inline void _atomic_flags_wake(std::atomic<uint32_t>& p_word) noexcept
+  {
+#if defined(_WIN32)
+    ::WakeByAddressAll(&p_word);
+#elif defined(__linux__)
+    ::syscall(SYS_futex, &p_word, FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#else
+    // Lock orders change of word before waiting thread's check
+    (void)p_word;
+    {
+      std::lock_guard<std::mutex> guard(_atomic_flags_mutex());
+    }
+    _atomic_flags_condition().notify_all();
+#endif
+  }
+
+  template<class T>
+  inline atomic_flags<T>::atomic_flags(T p_flags) noexcept
+    : m_flags(_underlying_value(p_flags))
+  {
+  }
+
+  template<class T>
+  inline atomic_flags<T>::operator T(void) const noexcept
+  {
+    return load();
+  }
+
+  template<class T>
+  inline T atomic_flags<T>::clear(T p_flags) noexcept
+  {
+    // Waiting threads wait only for set flags, so they are not signaled
+    return static_cast<T>(m_flags.fetch_and(_underlying_value(~p_flags)));
+  }
+
+  template<class T>
+  inline T atomic_flags<T>::load(void) const noexcept
+  {
+    return static_cast<T>(m_flags.load(std::memory_order_acquire));
+  }
+
+  template<class T>
+  inline T atomic_flags<T>::set(T p_flags) noexcept
+  {
+    auto previous = static_cast<T>(m_flags.fetch_or(_underlying_value(p_flags)));
+    _notify(previous, previous | p_flags);
+    return previous;
+  }
+
+  template<class T>
+  inline T atomic_flags<T>::store(T p_flags) noexcept
+  {
+    auto previous = static_cast<T>(m_flags.exchange(_underlying_value(p_flags)));
+    _notify(previous, p_flags);
+    return previous;
+  }
+
+  template<class T>
+  inline bool atomic_flags<T>::test(T p_flags) const noexcept
+  {
+    return is_flag_set(load(), p_flags);
+  }
+
+  template<class T>
+  inline bool atomic_flags<T>::test_and_set(T p_flags) noexcept
+  {
+    return is_flag_set(set(p_flags), p_flags);
+  }
+
+  template<class T>
+  inline T atomic_flags<T>::toggle(T p_flags) noexcept
+  {
+    auto previous = static_cast<T>(m_flags.fetch_xor(_underlying_value(p_flags)));
+    _notify(previous, previous ^ p_flags);
+    return previous;
+  }
+
+  template<class T>
+  inline T atomic_flags<T>::wait_all(T p_flags) noexcept
+  {
+    return _wait([p_flags](T p_value)
+      {
+        return is_flag_set(p_value, p_flags);
+      });
+  }
+
+  template<class T>
+  inline T atomic_flags<T>::wait_any(T p_flags) noexcept
+  {
+    return _wait([p_flags](T p_value)
+      {
+        return static_cast<T>(0) != (p_value & p_flags);
+      });
+  }
+
+  template<class T>
+  inline void atomic_flags<T>::_notify(T p_previous, T p_current) noexcept
+  {
+    // Sequentially consistent modification of flags and load of waiter count pair with waiting thread's increment of
+    // waiter count and load of flags, so that either waiting thread observes new flags or it is signaled
+    if (static_cast<T>(0) != (p_current & ~p_previous) && 0 != m_waiters.load())
+    {
+      m_epoch.fetch_add(1);
+      _atomic_flags_wake(m_epoch);
+    }
+  }
+
+  template<class T>
+  template<class Predicate>
+  inline T atomic_flags<T>::_wait(Predicate p_predicate) noexcept
+  {
+    auto flags = load();
+    if (p_predicate(flags))
+    {
+      return flags;
+    }
+    m_waiters.fetch_add(1);
+    for (;;)
+    {
+      auto epoch = m_epoch.load();
+      flags = static_cast<T>(m_flags.load());
+      if (p_predicate(flags))
+      {
+        break;
+      }
+      _atomic_flags_wait(m_epoch, epoch);
+    }
+    m_waiters.fetch_sub(1);
+    return flags;
+  }
+#pragma endregion
+}
\ No newline at end of file
@@ -9,9 +9,24 @@
 #  include <cstdlib>
 #endif
 
+#if defined(_MSC_VER)
+#  include <intrin.h>
+#endif
+
+#if !defined(FLIB_NO_BMI2) & (defined(__BMI2__) | defined(__AVX2__) & defined(_MSC_VER))
+#  define FLIB_BMI2
+#  include <immintrin.h>
+#endif
+
 namespace flib
 {
 #pragma region API
+  // Optional macros:
+  //  - FLIB_NO_BMI2 ... disables use of BMI2 pdep/pext instructions in Morton code conversions
+  //
+  // BMI2 instructions are used only when enabled for compilation (e.g. -mbmi2 or -march=native for gcc/clang,
+  // /arch:AVX2 for msvc), otherwise portable magic bits implementation is used
+
   // Class for determination of platform byte endianess
   class endian
   {
@@ -61,6 +76,184 @@ namespace flib
   //   p_data_start - Pointer to the first byte of contiguous memory block
   //     p_data_end - Pointer to byte after last byte of contiguous memory block
   void byteswap(uint8_t* p_data_start, uint8_t* p_data_end) noexcept;
+
+  // Method for counting set bits of 64-bit unsigned integer
+  //
+  // Parameters:
+  //   p_data - 64-bit unsigned integer
+  //
+  // Returns:
+  //   number of set bits
+  uint8_t popcount(uint64_t p_data) noexcept;
+
+  // Method for counting consecutive unset bits of 64-bit unsigned integer, starting from least significant bit
+  //
+  // Parameters:
+  //   p_data - 64-bit unsigned integer
+  //
+  // Returns:
+  //   index of least significant set bit or 64 if no bits are set
+  uint8_t countr_zero(uint64_t p_data) noexcept;
+
+  // Method for interleaving two 16-bit coordinates into 32-bit Morton (Z-order) code
+  //
+  // Parameters:
+  //   p_x - x coordinate (occupies even code bits)
+  //   p_y - y coordinate (occupies odd code bits)
+  //
+  // Returns:
+  //   32-bit Morton code
+  uint32_t morton2d_encode32(uint16_t p_x, uint16_t p_y) noexcept;
+
+  // Method for interleaving two 32-bit coordinates into 64-bit Morton (Z-order) code
+  //
+  // Parameters:
+  //   p_x - x coordinate (occupies even code bits)
+  //   p_y - y coordinate (occupies odd code bits)
+  //
+  // Returns:
+  //   64-bit Morton code
+  uint64_t morton2d_encode64(uint32_t p_x, uint32_t p_y) noexcept;
+
+  // Method for interleaving three 10-bit coordinates into 30-bit Morton (Z-order) code
+  //
+  // Parameters:
+  //   p_x - x coordinate (only lowest 10 bits are used)
+  //   p_y - y coordinate (only lowest 10 bits are used)
+  //   p_z - z coordinate (only lowest 10 bits are used)
+  //
+  // Returns:
+  //   32-bit Morton code
+  uint32_t morton3d_encode32(uint16_t p_x, uint16_t p_y, uint16_t p_z) noexcept;
+
+  // Method for interleaving three 21-bit coordinates into 63-bit Morton (Z-order) code
+  //
+  // Parameters:
+  //   p_x - x coordinate (only lowest 21 bits are used)
+  //   p_y - y coordinate (only lowest 21 bits are used)
+  //   p_z - z coordinate (only lowest 21 bits are used)
+  //
+  // Returns:
+  //   64-bit Morton code
+  uint64_t morton3d_encode64(uint32_t p_x, uint32_t p_y, uint32_t p_z) noexcept;
+
+  // Method for deinterleaving 32-bit Morton (Z-order) code into two 16-bit coordinates
+  //
+  // Parameters:
+  //   p_code - 32-bit Morton code
+  //      p_x - Decoded x coordinate
+  //      p_y - Decoded y coordinate
+  void morton2d_decode32(uint32_t p_code, uint16_t& p_x, uint16_t& p_y) noexcept;
+
+  // Method for deinterleaving 64-bit Morton (Z-order) code into two 32-bit coordinates
+  //
+  // Parameters:
+  //   p_code - 64-bit Morton code
+  //      p_x - Decoded x coordinate
+  //      p_y - Decoded y coordinate
+  void morton2d_decode64(uint64_t p_code, uint32_t& p_x, uint32_t& p_y) noexcept;
+
+  // Method for deinterleaving 30-bit Morton (Z-order) code into three 10-bit coordinates
+  //
+  // Parameters:
+  //   p_code - 32-bit Morton code
+  //      p_x - Decoded x coordinate
+  //      p_y - Decoded y coordinate
+  //      p_z - Decoded z coordinate
+  void morton3d_decode32(uint32_t p_code, uint16_t& p_x, uint16_t& p_y, uint16_t& p_z) noexcept;
+
+  // Method for deinterleaving 63-bit Morton (Z-order) code into three 21-bit coordinates
+  //
+  // Parameters:
+  //   p_code - 64-bit Morton code
+  //      p_x - Decoded x coordinate
+  //      p_y - Decoded y coordinate
+  //      p_z - Decoded z coordinate
+  void morton3d_decode64(uint64_t p_code, uint32_t& p_x, uint32_t& p_y, uint32_t& p_z) noexcept;
+
+  // Method for bulk interleaving of 16-bit coordinate arrays into 32-bit Morton codes
+  //
+  // Parameters:
+  //   p_x_start - Pointer to the first x coordinate
+  //     p_x_end - Pointer to element after last x coordinate
+  //   p_y_start - Pointer to the first y coordinate
+  //      p_code - Pointer to the first element of output array
+  void morton2d_encode32(const uint16_t* p_x_start, const uint16_t* p_x_end, const uint16_t* p_y_start,
+    uint32_t* p_code) noexcept;
+
+  // Method for bulk interleaving of 32-bit coordinate arrays into 64-bit Morton codes
+  //
+  // Parameters:
+  //   p_x_start - Pointer to the first x coordinate
+  //     p_x_end - Pointer to element after last x coordinate
+  //   p_y_start - Pointer to the first y coordinate
+  //      p_code - Pointer to the first element of output array
+  void morton2d_encode64(const uint32_t* p_x_start, const uint32_t* p_x_end, const uint32_t* p_y_start,
+    uint64_t* p_code) noexcept;
+
+  // Method for bulk interleaving of 10-bit coordinate arrays into 32-bit Morton codes
+  //
+  // Parameters:
+  //   p_x_start - Pointer to the first x coordinate
+  //     p_x_end - Pointer to element after last x coordinate
+  //   p_y_start - Pointer to the first y coordinate
+  //   p_z_start - Pointer to the first z coordinate
+  //      p_code - Pointer to the first element of output array
+  void morton3d_encode32(const uint16_t* p_x_start, const uint16_t* p_x_end, const uint16_t* p_y_start,
+    const uint16_t* p_z_start, uint32_t* p_code) noexcept;
+
+  // Method for bulk interleaving of 21-bit coordinate arrays into 64-bit Morton codes
+  //
+  // Parameters:
+  //   p_x_start - Pointer to the first x coordinate
+  //     p_x_end - Pointer to element after last x coordinate
+  //   p_y_start - Pointer to the first y coordinate
+  //   p_z_start - Pointer to the first z coordinate
+  //      p_code - Pointer to the first element of output array
+  void morton3d_encode64(const uint32_t* p_x_start, const uint32_t* p_x_end, const uint32_t* p_y_start,
+    const uint32_t* p_z_start, uint64_t* p_code) noexcept;
+
+  // Method for bulk deinterleaving of 32-bit Morton codes into 16-bit coordinate arrays
+  //
+  // Parameters:
+  //   p_code_start - Pointer to the first Morton code
+  //     p_code_end - Pointer to element after last Morton code
+  //            p_x - Pointer to the first element of x output array
+  //            p_y - Pointer to the first element of y output array
+  void morton2d_decode32(const uint32_t* p_code_start, const uint32_t* p_code_end, uint16_t* p_x,
+    uint16_t* p_y) noexcept;
+
+  // Method for bulk deinterleaving of 64-bit Morton codes into 32-bit coordinate arrays
+  //
+  // Parameters:
+  //   p_code_start - Pointer to the first Morton code
+  //     p_code_end - Pointer to element after last Morton code
+  //            p_x - Pointer to the first element of x output array
+  //            p_y - Pointer to the first element of y output array
+  void morton2d_decode64(const uint64_t* p_code_start, const uint64_t* p_code_end, uint32_t* p_x,
+    uint32_t* p_y) noexcept;
+
+  // Method for bulk deinterleaving of 32-bit Morton codes into 10-bit coordinate arrays
+  //
+  // Parameters:
+  //   p_code_start - Pointer to the first Morton code
+  //     p_code_end - Pointer to element after last Morton code
+  //            p_x - Pointer to the first element of x output array
+  //            p_y - Pointer to the first element of y output array
+  //            p_z - Pointer to the first element of z output array
+  void morton3d_decode32(const uint32_t* p_code_start, const uint32_t* p_code_end, uint16_t* p_x, uint16_t* p_y,
+    uint16_t* p_z) noexcept;
+
+  // Method for bulk deinterleaving of 64-bit Morton codes into 21-bit coordinate arrays
+  //
+  // Parameters:
+  //   p_code_start - Pointer to the first Morton code
+  //     p_code_end - Pointer to element after last Morton code
+  //            p_x - Pointer to the first element of x output array
+  //            p_y - Pointer to the first element of y output array
+  //            p_z - Pointer to the first element of z output array
+  void morton3d_decode64(const uint64_t* p_code_start, const uint64_t* p_code_end, uint32_t* p_x, uint32_t* p_y,
+    uint32_t* p_z) noexcept;
 #pragma endregion
 
 #pragma region IMPLEMENTATION
@@ -120,5 +313,271 @@ namespace flib
       *p_data_end = temp;
     }
   }
+
+  inline uint8_t popcount(uint64_t p_data) noexcept
+  {
+#if   defined(_MSC_VER) & defined(_M_X64)
+    return static_cast<uint8_t>(__popcnt64(p_data));
+#elif defined(__GNUC__)
+    return static_cast<uint8_t>(__builtin_popcountll(p_data));
+#else
+    p_data = p_data - (p_data >> 1 & 0x5555555555555555ull);
+    p_data = (p_data & 0x3333333333333333ull) + (p_data >> 2 & 0x3333333333333333ull);
+    p_data = (p_data + (p_data >> 4)) & 0x0f0f0f0f0f0f0f0full;
+    return static_cast<uint8_t>(p_data * 0x0101010101010101ull >> 56);
+#endif
+  }
+
+  inline uint8_t countr_zero(uint64_t p_data) noexcept
+  {
+    if (0 == p_data)
+    {
+      return 64;
+    }
+#if   defined(_MSC_VER) & defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, p_data);
+    return static_cast<uint8_t>(index);
+#elif defined(__GNUC__)
+    return static_cast<uint8_t>(__builtin_ctzll(p_data));
+#else
+    return popcount((p_data & (0 - p_data)) - 1);
+#endif
+  }
+
+  inline uint32_t _morton_spread2(uint32_t p_value) noexcept
+  {
+    p_value &= 0x0000fffful;
+    p_value = (p_value | p_value << 8) & 0x00ff00fful;
+    p_value = (p_value | p_value << 4) & 0x0f0f0f0ful;
+    p_value = (p_value | p_value << 2) & 0x33333333ul;
+    return (p_value | p_value << 1) & 0x55555555ul;
+  }
+
+  inline uint64_t _morton_spread2(uint64_t p_value) noexcept
+  {
+    p_value &= 0x00000000ffffffffull;
+    p_value = (p_value | p_value << 16) & 0x0000ffff0000ffffull;
+    p_value = (p_value | p_value << 8) & 0x00ff00ff00ff00ffull;
+    p_value = (p_value | p_value << 4) & 0x0f0f0f0f0f0f0f0full;
+    p_value = (p_value | p_value << 2) & 0x3333333333333333ull;
+    return (p_value | p_value << 1) & 0x5555555555555555ull;
+  }
+
+  inline uint32_t _morton_compact2(uint32_t p_value) noexcept
+  {
+    p_value &= 0x55555555ul;
+    p_value = (p_value | p_value >> 1) & 0x33333333ul;
+    p_value = (p_value | p_value >> 2) & 0x0f0f0f0ful;
+    p_value = (p_value | p_value >> 4) & 0x00ff00fful;
+    return (p_value | p_value >> 8) & 0x0000fffful;
+  }
+
+  inline uint64_t _morton_compact2(uint64_t p_value) noexcept
+  {
+    p_value &= 0x5555555555555555ull;
+    p_value = (p_value | p_value >> 1) & 0x3333333333333333ull;
+    p_value = (p_value | p_value >> 2) & 0x0f0f0f0f0f0f0f0full;
+    p_value = (p_value | p_value >> 4) & 0x00ff00ff00ff00ffull;
+    p_value = (p_value | p_value >> 8) & 0x0000ffff0000ffffull;
+    return (p_value | p_value >> 16) & 0x00000000ffffffffull;
+  }
+
+  inline uint32_t _morton_spread3(uint32_t p_value) noexcept
+  {
+    p_value &= 0x000003fful;
+    p_value = (p_value | p_value << 16) & 0x030000fful;
+    p_value = (p_value | p_value << 8) & 0x0300f00ful;
+    p_value = (p_value | p_value << 4) & 0x030c30c3ul;
+    return (p_value | p_value << 2) & 0x09249249ul;
+  }
+
+  inline uint64_t _morton_spread3(uint64_t p_value) noexcept
+  {
+    p_value &= 0x00000000001fffffull;
+    p_value = (p_value | p_value << 32) & 0x001f00000000ffffull;
+    p_value = (p_value | p_value << 16) & 0x001f0000ff0000ffull;
+    p_value = (p_value | p_value << 8) & 0x100f00f00f00f00full;
+    p_value = (p_value | p_value << 4) & 0x10c30c30c30c30c3ull;
+    return (p_value | p_value << 2) & 0x1249249249249249ull;
+  }
+
+  inline uint32_t _morton_compact3(uint32_t p_value) noexcept
+  {
+    p_value &= 0x09249249ul;
+    p_value = (p_value | p_value >> 2) & 0x030c30c3ul;
+    p_value = (p_value | p_value >> 4) & 0x0300f00ful;
+    p_value = (p_value | p_value >> 8) & 0x030000fful;
+    return (p_value | p_value >> 16) & 0x000003fful;
+  }
+
+  inline uint64_t _morton_compact3(uint64_t p_value) noexcept
+  {
+    p_value &= 0x1249249249249249ull;
+    p_value = (p_value | p_value >> 2) & 0x10c30c30c30c30c3ull;
+    p_value = (p_value | p_value >> 4) & 0x100f00f00f00f00full;
+    p_value = (p_value | p_value >> 8) & 0x001f0000ff0000ffull;
+    p_value = (p_value | p_value >> 16) & 0x001f00000000ffffull;
+    return (p_value | p_value >> 32) & 0x00000000001fffffull;
+  }
+
+  inline uint32_t morton2d_encode32(uint16_t p_x, uint16_t p_y) noexcept
+  {
+#if defined(FLIB_BMI2)
+    return _pdep_u32(p_x, 0x55555555ul) | _pdep_u32(p_y, 0xaaaaaaaaul);
+#else
+    return _morton_spread2(static_cast<uint32_t>(p_x)) | _morton_spread2(static_cast<uint32_t>(p_y)) << 1;
+#endif
+  }
+
+  inline uint64_t morton2d_encode64(uint32_t p_x, uint32_t p_y) noexcept
+  {
+#if defined(FLIB_BMI2) & (defined(__x86_64__) | defined(_M_X64))
+    return _pdep_u64(p_x, 0x5555555555555555ull) | _pdep_u64(p_y, 0xaaaaaaaaaaaaaaaaull);
+#else
+    return _morton_spread2(static_cast<uint64_t>(p_x)) | _morton_spread2(static_cast<uint64_t>(p_y)) << 1;
+#endif
+  }
+
+  inline uint32_t morton3d_encode32(uint16_t p_x, uint16_t p_y, uint16_t p_z) noexcept
+  {
+#if defined(FLIB_BMI2)
+    return _pdep_u32(p_x, 0x09249249ul) | _pdep_u32(p_y, 0x12492492ul) | _pdep_u32(p_z, 0x24924924ul);
+#else
+    return _morton_spread3(static_cast<uint32_t>(p_x)) | _morton_spread3(static_cast<uint32_t>(p_y)) << 1 |
+      _morton_spread3(static_cast<uint32_t>(p_z)) << 2;
+#endif
+  }
+
+  inline uint64_t morton3d_encode64(uint32_t p_x, uint32_t p_y, uint32_t p_z) noexcept
+  {
+#if defined(FLIB_BMI2) & (defined(__x86_64__) | defined(_M_X64))
+    return _pdep_u64(p_x, 0x1249249249249249ull) | _pdep_u64(p_y, 0x2492492492492492ull) |
+      _pdep_u64(p_z, 0x4924924924924924ull);
+#else
+    return _morton_spread3(static_cast<uint64_t>(p_x)) | _morton_spread3(static_cast<uint64_t>(p_y)) << 1 |
+      _morton_spread3(static_cast<uint64_t>(p_z)) << 2;
+#endif
+  }
+
+  inline void morton2d_decode32(uint32_t p_code, uint16_t& p_x, uint16_t& p_y) noexcept
+  {
+#if defined(FLIB_BMI2)
+    p_x = static_cast<uint16_t>(_pext_u32(p_code, 0x55555555ul));
+    p_y = static_cast<uint16_t>(_pext_u32(p_code, 0xaaaaaaaaul));
+#else
+    p_x = static_cast<uint16_t>(_morton_compact2(p_code));
+    p_y = static_cast<uint16_t>(_morton_compact2(p_code >> 1));
+#endif
+  }
+
+  inline void morton2d_decode64(uint64_t p_code, uint32_t& p_x, uint32_t& p_y) noexcept
+  {
+#if defined(FLIB_BMI2) & (defined(__x86_64__) | defined(_M_X64))
+    p_x = static_cast<uint32_t>(_pext_u64(p_code, 0x5555555555555555ull));
+    p_y = static_cast<uint32_t>(_pext_u64(p_code, 0xaaaaaaaaaaaaaaaaull));
+#else
+    p_x = static_cast<uint32_t>(_morton_compact2(p_code));
+    p_y = static_cast<uint32_t>(_morton_compact2(p_code >> 1));
+#endif
+  }
+
+  inline void morton3d_decode32(uint32_t p_code, uint16_t& p_x, uint16_t& p_y, uint16_t& p_z) noexcept
+  {
+#if defined(FLIB_BMI2)
+    p_x = static_cast<uint16_t>(_pext_u32(p_code, 0x09249249ul));
+    p_y = static_cast<uint16_t>(_pext_u32(p_code, 0x12492492ul));
+    p_z = static_cast<uint16_t>(_pext_u32(p_code, 0x24924924ul));
+#else
+    p_x = static_cast<uint16_t>(_morton_compact3(p_code));
+    p_y = static_cast<uint16_t>(_morton_compact3(p_code >> 1));
+    p_z = static_cast<uint16_t>(_morton_compact3(p_code >> 2));
+#endif
+  }
+
+  inline void morton3d_decode64(uint64_t p_code, uint32_t& p_x, uint32_t& p_y, uint32_t& p_z) noexcept
+  {
+#if defined(FLIB_BMI2) & (defined(__x86_64__) | defined(_M_X64))
+    p_x = static_cast<uint32_t>(_pext_u64(p_code, 0x1249249249249249ull));
+    p_y = static_cast<uint32_t>(_pext_u64(p_code, 0x2492492492492492ull));
+    p_z = static_cast<uint32_t>(_pext_u64(p_code, 0x4924924924924924ull));
+#else
+    p_x = static_cast<uint32_t>(_morton_compact3(p_code));
+    p_y = static_cast<uint32_t>(_morton_compact3(p_code >> 1));
+    p_z = static_cast<uint32_t>(_morton_compact3(p_code >> 2));
+#endif
+  }
+
+  inline void morton2d_encode32(const uint16_t* p_x_start, const uint16_t* p_x_end, const uint16_t* p_y_start,
+    uint32_t* p_code) noexcept
+  {
+    for (; p_x_start != p_x_end; ++p_x_start, ++p_y_start, ++p_code)
+    {
+      *p_code = morton2d_encode32(*p_x_start, *p_y_start);
+    }
+  }
+
+  inline void morton2d_encode64(const uint32_t* p_x_start, const uint32_t* p_x_end, const uint32_t* p_y_start,
+    uint64_t* p_code) noexcept
+  {
+    for (; p_x_start != p_x_end; ++p_x_start, ++p_y_start, ++p_code)
+    {
+      *p_code = morton2d_encode64(*p_x_start, *p_y_start);
+    }
+  }
+
+  inline void morton3d_encode32(const uint16_t* p_x_start, const uint16_t* p_x_end, const uint16_t* p_y_start,
+    const uint16_t* p_z_start, uint32_t* p_code) noexcept
+  {
+    for (; p_x_start != p_x_end; ++p_x_start, ++p_y_start, ++p_z_start, ++p_code)
+    {
+      *p_code = morton3d_encode32(*p_x_start, *p_y_start, *p_z_start);
+    }
+  }
+
+  inline void morton3d_encode64(const uint32_t* p_x_start, const uint32_t* p_x_end, const uint32_t* p_y_start,
+    const uint32_t* p_z_start, uint64_t* p_code) noexcept
+  {
+    for (; p_x_start != p_x_end; ++p_x_start, ++p_y_start, ++p_z_start, ++p_code)
+    {
+      *p_code = morton3d_encode64(*p_x_start, *p_y_start, *p_z_start);
+    }
+  }
+
+  inline void morton2d_decode32(const uint32_t* p_code_start, const uint32_t* p_code_end, uint16_t* p_x,
+    uint16_t* p_y) noexcept
+  {
+    for (; p_code_start != p_code_end; ++p_code_start, ++p_x, ++p_y)
+    {
+      morton2d_decode32(*p_code_start, *p_x, *p_y);
+    }
+  }
+
+  inline void morton2d_decode64(const uint64_t* p_code_start, const uint64_t* p_code_end, uint32_t* p_x,
+    uint32_t* p_y) noexcept
+  {
+    for (; p_code_start != p_code_end; ++p_code_start, ++p_x, ++p_y)
+    {
+      morton2d_decode64(*p_code_start, *p_x, *p_y);
+    }
+  }
+
+  inline void morton3d_decode32(const uint32_t* p_code_start, const uint32_t* p_code_end, uint16_t* p_x, uint16_t* p_y,
+    uint16_t* p_z) noexcept
+  {
+    for (; p_code_start != p_code_end; ++p_code_start, ++p_x, ++p_y, ++p_z)
+    {
+      morton3d_decode32(*p_code_start, *p_x, *p_y, *p_z);
+    }
+  }
+
+  inline void morton3d_decode64(const uint64_t* p_code_start, const uint64_t* p_code_end, uint32_t* p_x, uint32_t* p_y,
+    uint32_t* p_z) noexcept
+  {
+    for (; p_code_start != p_code_end; ++p_code_start, ++p_x, ++p_y, ++p_z)
+    {
+      morton3d_decode64(*p_code_start, *p_x, *p_y, *p_z);
+    }
+  }
 #pragma endregion
 }
\ No newline at end of file
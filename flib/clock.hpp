@@ -0,0 +1,323 @@
+// Copyright © 2024 Luka Arnecic.
+// See the LICENSE file at the top-level directory of this distribution.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#if defined(__linux__)
+#  include <time.h>
+#endif
+
+#if !defined(FLIB_NO_TSC) & (defined(__x86_64__) | defined(_M_X64) | defined(__i386__) | defined(_M_IX86))
+#  define FLIB_TSC
+#  if defined(_MSC_VER)
+#    include <intrin.h>
+#  else
+#    include <cpuid.h>
+#    include <x86intrin.h>
+#  endif
+#endif
+
+namespace flib
+{
+#pragma region API
+  // Optional macros:
+  //  - FLIB_NO_TSC ... disables use of time stamp counter, so that tsc_clock forwards to its reference clock
+  //
+  // Clocks satisfy chrono Clock requirements and share time point type with standard clocks, so that their time points
+  // can be used with timestamp generation (system clock based clocks) or basic_timer (steady clock based clocks)
+
+  // System clock with resolution of kernel tick (typically 1-4 ms), which avoids reading of hardware clock source
+  // (CLOCK_REALTIME_COARSE on linux, system_clock elsewhere)
+  class coarse_system_clock
+  {
+  public:
+    using duration = std::chrono::system_clock::duration;
+    using rep = duration::rep;
+    using period = duration::period;
+    using time_point = std::chrono::system_clock::time_point;
+
+    static constexpr bool is_steady = false;
+
+  public:
+    static time_point now(void) noexcept;
+  };
+
+  // Steady clock with resolution of kernel tick (typically 1-4 ms), which avoids reading of hardware clock source
+  // (CLOCK_MONOTONIC_COARSE on linux, steady_clock elsewhere)
+  class coarse_steady_clock
+  {
+  public:
+    using duration = std::chrono::steady_clock::duration;
+    using rep = duration::rep;
+    using period = duration::period;
+    using time_point = std::chrono::steady_clock::time_point;
+
+    static constexpr bool is_steady = true;
+
+  public:
+    static time_point now(void) noexcept;
+  };
+
+  // Clock converting invariant time stamp counter (rdtsc) into time of reference clock with multiply-shift
+  //
+  // Conversion is calibrated against reference clock on first use (for about 1 ms) and resynchronized periodically
+  // (every second at most) by slewing conversion rate, so that clock stays continuous and increasing. Differences
+  // larger than 1 ms (e.g. system clock adjustments) are stepped over (forward only for steady reference clock).
+  // Without invariant time stamp counter, reference clock is used directly.
+  template<class Reference = std::chrono::steady_clock>
+  class tsc_clock
+  {
+  public:
+    using duration = typename Reference::duration;
+    using rep = typename duration::rep;
+    using period = typename duration::period;
+    using time_point = typename Reference::time_point;
+
+    static constexpr bool is_steady = Reference::is_steady;
+
+  public:
+    static time_point now(void) noexcept;
+
+    // Method for checking whether clock is backed by invariant time stamp counter
+    //
+    // Returns:
+    //   true if time stamp counter is used, otherwise false
+    static bool supported(void) noexcept;
+
+  private:
+    struct _state_t
+    {
+      std::atomic<uint64_t> m_sequence{ 0 };
+      std::atomic<uint64_t> m_base_ticks{ 0 };
+      std::atomic<int64_t> m_base_time{ 0 };
+      std::atomic<uint64_t> m_multiplier{ 0 };
+      std::atomic<uint64_t> m_resync_ticks{ 0 };
+      uint64_t m_sync_ticks{ 0 };
+      int64_t m_sync_time{ 0 };
+      uint64_t m_interval{ 0 };
+      bool m_supported{ false };
+
+      _state_t(void) noexcept;
+    };
+
+    static constexpr int64_t s_step_threshold = 1000000;
+    static constexpr int64_t s_resync_period = 1000000000;
+
+  private:
+    static int64_t _convert(uint64_t p_ticks, uint64_t p_base_ticks, int64_t p_base_time, uint64_t p_multiplier) noexcept;
+    static uint64_t _mul_shift32(uint64_t p_value, uint64_t p_multiplier) noexcept;
+    static int64_t _reference_now(void) noexcept;
+    static void _resync(_state_t& p_state) noexcept;
+    static _state_t& _state(void) noexcept;
+    static uint64_t _ticks(void) noexcept;
+  };
+
+  using tsc_system_clock = tsc_clock<std::chrono::system_clock>;
+  using tsc_steady_clock = tsc_clock<std::chrono::steady_clock>;
+#pragma endregion
+
+#pragma region IMPLEMENTATION
+  template<class Reference>
+  constexpr bool tsc_clock<Reference>::is_steady;
+
+  inline coarse_system_clock::time_point coarse_system_clock::now(void) noexcept
+  {
+#if defined(__linux__) & defined(CLOCK_REALTIME_COARSE)
+    timespec time{};
+    clock_gettime(CLOCK_REALTIME_COARSE, &time);
+    return time_point(std::chrono::duration_cast<duration>(std::chrono::seconds(time.tv_sec) +
+      std::chrono::nanoseconds(time.tv_nsec)));
+#else
+    return std::chrono::system_clock::now();
+#endif
+  }
+
+  inline coarse_steady_clock::time_point coarse_steady_clock::now(void) noexcept
+  {
+#if defined(__linux__) & defined(CLOCK_MONOTONIC_COARSE)
+    timespec time{};
+    clock_gettime(CLOCK_MONOTONIC_COARSE, &time);
+    return time_point(std::chrono::duration_cast<duration>(std::chrono::seconds(time.tv_sec) +
+      std::chrono::nanoseconds(time.tv_nsec)));
+#else
+    return std::chrono::steady_clock::now();
+#endif
+  }
+
+  template<class Reference>
+  inline typename tsc_clock<Reference>::time_point tsc_clock<Reference>::now(void) noexcept
+  {
+    auto& state = _state();
+    if (!state.m_supported)
+    {
+      return Reference::now();
+    }
+    for (;;)
+    {
+      // Seqlock read of conversion parameters, with resynchronization performed by reader which acquires the lock
+      auto sequence = state.m_sequence.load(std::memory_order_acquire);
+      auto base_ticks = state.m_base_ticks.load(std::memory_order_relaxed);
+      auto base_time = state.m_base_time.load(std::memory_order_relaxed);
+      auto multiplier = state.m_multiplier.load(std::memory_order_relaxed);
+      auto resync_ticks = state.m_resync_ticks.load(std::memory_order_relaxed);
+      // Ticks are read within read section, so that ticks read after concurrent resynchronization moved base are
+      // never converted with previous multiplier
+      auto ticks = _ticks();
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (0 != (sequence & 1) || state.m_sequence.load(std::memory_order_relaxed) != sequence)
+      {
+        continue;
+      }
+      if (ticks - base_ticks < resync_ticks - base_ticks ||
+        !state.m_sequence.compare_exchange_strong(sequence, sequence + 1, std::memory_order_acquire))
+      {
+        return time_point(std::chrono::duration_cast<duration>(
+          std::chrono::nanoseconds(_convert(ticks, base_ticks, base_time, multiplier))));
+      }
+      std::atomic_thread_fence(std::memory_order_release);
+      _resync(state);
+      state.m_sequence.store(sequence + 2, std::memory_order_release);
+    }
+  }
+
+  template<class Reference>
+  inline bool tsc_clock<Reference>::supported(void) noexcept
+  {
+    return _state().m_supported;
+  }
+
+  template<class Reference>
+  inline tsc_clock<Reference>::_state_t::_state_t(void) noexcept
+  {
+#if defined(FLIB_TSC)
+    unsigned int registers[4]{};
+#  if defined(_MSC_VER)
+    __cpuid(reinterpret_cast<int*>(registers), static_cast<int>(0x80000000u));
+    if (0x80000007u <= registers[0])
+    {
+      __cpuid(reinterpret_cast<int*>(registers), static_cast<int>(0x80000007u));
+    }
+    else
+    {
+      registers[3] = 0;
+    }
+#  else
+    if (!__get_cpuid(0x80000007u, &registers[0], &registers[1], &registers[2], &registers[3]))
+    {
+      registers[3] = 0;
+    }
+#  endif
+    // Invariant TSC (CPUID.80000007H:EDX[8])
+    m_supported = 0 != (registers[3] & 0x100u);
+#endif
+    if (!m_supported)
+    {
+      return;
+    }
+    auto start_ticks = _ticks();
+    auto start_time = _reference_now();
+    auto ticks = start_ticks;
+    auto time = start_time;
+    while (time - start_time < s_step_threshold)
+    {
+      ticks = _ticks();
+      time = _reference_now();
+    }
+    if (ticks == start_ticks)
+    {
+      m_supported = false;
+      return;
+    }
+    auto multiplier = static_cast<uint64_t>(static_cast<double>(time - start_time) * 4294967296.0 /
+      static_cast<double>(ticks - start_ticks));
+    m_interval = (ticks - start_ticks) * 10;
+    m_sync_ticks = ticks;
+    m_sync_time = time;
+    m_base_ticks.store(ticks, std::memory_order_relaxed);
+    m_base_time.store(time, std::memory_order_relaxed);
+    m_multiplier.store(0 != multiplier ? multiplier : 1, std::memory_order_relaxed);
+    m_resync_ticks.store(ticks + m_interval, std::memory_order_relaxed);
+  }
+
+  template<class Reference>
+  inline int64_t tsc_clock<Reference>::_convert(uint64_t p_ticks, uint64_t p_base_ticks, int64_t p_base_time,
+    uint64_t p_multiplier) noexcept
+  {
+    return p_base_time + static_cast<int64_t>(_mul_shift32(p_ticks - p_base_ticks, p_multiplier));
+  }
+
+  template<class Reference>
+  inline uint64_t tsc_clock<Reference>::_mul_shift32(uint64_t p_value, uint64_t p_multiplier) noexcept
+  {
+    // (value * multiplier) >> 32 without 128-bit intermediate
+    auto value_high = p_value >> 32;
+    auto value_low = p_value & 0xffffffffull;
+    auto multiplier_high = p_multiplier >> 32;
+    auto multiplier_low = p_multiplier & 0xffffffffull;
+    return value_high * p_multiplier + value_low * multiplier_high + (value_low * multiplier_low >> 32);
+  }
+
+  template<class Reference>
+  inline int64_t tsc_clock<Reference>::_reference_now(void) noexcept
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Reference::now().time_since_epoch()).count();
+  }
+
+  template<class Reference>
+  inline void tsc_clock<Reference>::_resync(_state_t& p_state) noexcept
+  {
+    auto start_ticks = _ticks();
+    auto time = _reference_now();
+    auto ticks = start_ticks + (_ticks() - start_ticks) / 2;
+    auto base_ticks = p_state.m_base_ticks.load(std::memory_order_relaxed);
+    auto base_time = p_state.m_base_time.load(std::memory_order_relaxed);
+    auto multiplier = p_state.m_multiplier.load(std::memory_order_relaxed);
+    auto measured = static_cast<double>(time - p_state.m_sync_time) * 4294967296.0 /
+      static_cast<double>(ticks - p_state.m_sync_ticks);
+    if (!(0 < measured))
+    {
+      measured = static_cast<double>(multiplier);
+    }
+    // Period is extended until it reaches resync period, to quickly refine initial calibration
+    auto interval_limit = static_cast<uint64_t>(static_cast<double>(s_resync_period) * 4294967296.0 / measured);
+    p_state.m_interval = p_state.m_interval * 2 < interval_limit ? p_state.m_interval * 2 : interval_limit;
+    auto predicted = _convert(ticks, base_ticks, base_time, multiplier);
+    auto error = time - predicted;
+    if (error < -s_step_threshold || s_step_threshold < error)
+    {
+      predicted = Reference::is_steady && time < predicted ? predicted : time;
+      error = 0;
+    }
+    // Error is slewed out over following interval, with rate kept at least half of measured one
+    auto slewed = measured + static_cast<double>(error) * 4294967296.0 / static_cast<double>(p_state.m_interval);
+    multiplier = static_cast<uint64_t>(slewed < measured / 2 ? measured / 2 : slewed);
+    p_state.m_sync_ticks = ticks;
+    p_state.m_sync_time = time;
+    p_state.m_base_ticks.store(ticks, std::memory_order_relaxed);
+    p_state.m_base_time.store(predicted, std::memory_order_relaxed);
+    p_state.m_multiplier.store(0 != multiplier ? multiplier : 1, std::memory_order_relaxed);
+    p_state.m_resync_ticks.store(ticks + p_state.m_interval, std::memory_order_relaxed);
+  }
+
+  template<class Reference>
+  inline typename tsc_clock<Reference>::_state_t& tsc_clock<Reference>::_state(void) noexcept
+  {
+    static _state_t state;
+    return state;
+  }
+
+  template<class Reference>
+  inline uint64_t tsc_clock<Reference>::_ticks(void) noexcept
+  {
+#if defined(FLIB_TSC)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+  }
+#pragma endregion
+}
\ No newline at end of file
@@ -3,11 +3,29 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <stdexcept>
 #include <type_traits>
+#include <utility>
+
+#include <flib/bit.hpp>
+
+#if !defined(FLIB_NO_SSE2) & (defined(__SSE2__) | defined(_M_X64))
+#  define FLIB_SSE2
+#  include <emmintrin.h>
+#endif
 
 namespace flib
 {
 #pragma region API
+  // Optional macros:
+  //  - FLIB_NO_SSE2 ... disables use of SSE2 instructions in operations of enum_bitset
+  //
+  // SSE2 instructions are used when enabled for compilation (default for x86-64), otherwise enum_bitset operations are
+  // performed with portable 64-bit word operations
+
   template<class T>
   using is_enum_t = typename std::enable_if<std::is_enum<T>::value>::type;
 
@@ -34,6 +52,181 @@ namespace flib
 
   template<class T, class = is_enum_t<T>>
   constexpr bool is_flag_set(T p_value, T p_flag);
+
+  // Value type over enum flags, which visits only set flags instead of testing every possible flag
+  template<class T>
+  class flag_set
+  {
+    static_assert(std::is_enum<T>::value, "Flags must be of enum type");
+
+  public:
+    using value_t = T;
+
+  public:
+    constexpr flag_set(void) noexcept = default;
+    constexpr flag_set(T p_flags) noexcept;
+    constexpr bool operator==(flag_set p_other) const noexcept;
+    constexpr bool operator!=(flag_set p_other) const noexcept;
+    constexpr flag_set operator~(void) const noexcept;
+    constexpr flag_set operator&(flag_set p_other) const noexcept;
+    constexpr flag_set operator|(flag_set p_other) const noexcept;
+    constexpr flag_set operator^(flag_set p_other) const noexcept;
+    constexpr flag_set& operator&=(flag_set p_other) noexcept;
+    constexpr flag_set& operator|=(flag_set p_other) noexcept;
+    constexpr flag_set& operator^=(flag_set p_other) noexcept;
+    constexpr bool any(void) const noexcept;
+    constexpr flag_set& clear(flag_set p_flags) noexcept;
+
+    // Method for counting set flags
+    //
+    // Returns:
+    //   number of set flags
+    std::size_t count(void) const noexcept;
+
+    // Method for visiting set flags in ascending order, skipping unset flags
+    //
+    // Parameters:
+    //   p_callable - callable invoked with every set flag (as single flag enum value)
+    template<class Callable>
+    void for_each(Callable&& p_callable) const;
+
+    constexpr bool none(void) const noexcept;
+    constexpr flag_set& set(flag_set p_flags) noexcept;
+
+    // Method for checking whether all given flags are set
+    //
+    // Parameters:
+    //   p_flags - flags to check
+    //
+    // Returns:
+    //   true if all given flags are set
+    constexpr bool test(flag_set p_flags) const noexcept;
+
+    constexpr flag_set& toggle(flag_set p_flags) noexcept;
+    constexpr T value(void) const noexcept;
+
+  private:
+    using _bits_t = typename std::make_unsigned<typename std::underlying_type<T>::type>::type;
+
+  private:
+    _bits_t m_flags{};
+  };
+
+  // Compile-time mapping of single flags to integral values (e.g. flag constants of external API), where set of flags
+  // is translated to bitwise OR of mapped values by one table lookup per 4 flag bits (tables hold combined values of
+  // all 16 combinations), or by single mask and shift if all flags map to equally shifted bits
+  template<class T, class Value>
+  class flag_map
+  {
+    static_assert(std::is_enum<T>::value, "Flags must be of enum type");
+    static_assert(std::is_integral<Value>::value, "Values must be of integral type");
+
+  public:
+    // Throws std::runtime_error if mapped flag is not single flag
+    constexpr flag_map(std::initializer_list<std::pair<T, Value>> p_entries);
+
+    // Method for translating flags
+    //
+    // Parameters:
+    //   p_flags - flags to translate (unmapped flags are ignored)
+    //
+    // Returns:
+    //   bitwise OR of values mapped to set flags
+    Value translate(flag_set<T> p_flags) const noexcept;
+
+  private:
+    using _bits_t = typename std::make_unsigned<typename std::underlying_type<T>::type>::type;
+
+    static constexpr std::size_t s_bits = sizeof(_bits_t) * 8;
+
+  private:
+    Value m_values[s_bits / 4][16]{};
+    _bits_t m_mapped{};
+    // Shift of mapped flags, valid only if all flags map to single bits at equal offset
+    int m_shift{};
+    bool m_shifted{};
+  };
+
+  // Fixed-size set of flags given by enum values used as bit indices (in range [0, N)), for sets with more flags than
+  // fit into enum underlying type, where bitwise operations and tests of whole sets process 128 bits per instruction
+  template<class T, std::size_t N>
+  class enum_bitset
+  {
+    static_assert(std::is_enum<T>::value, "Flags must be of enum type");
+    static_assert(N > 0, "Bitset must not be empty");
+
+  public:
+    using value_t = T;
+
+  public:
+    constexpr enum_bitset(void) noexcept = default;
+    // Throws std::runtime_error if any flag is out of range
+    constexpr enum_bitset(std::initializer_list<T> p_flags);
+    bool operator==(const enum_bitset& p_other) const noexcept;
+    bool operator!=(const enum_bitset& p_other) const noexcept;
+    enum_bitset operator~(void) const noexcept;
+    enum_bitset operator&(const enum_bitset& p_other) const noexcept;
+    enum_bitset operator|(const enum_bitset& p_other) const noexcept;
+    enum_bitset operator^(const enum_bitset& p_other) const noexcept;
+    enum_bitset& operator&=(const enum_bitset& p_other) noexcept;
+    enum_bitset& operator|=(const enum_bitset& p_other) noexcept;
+    enum_bitset& operator^=(const enum_bitset& p_other) noexcept;
+    bool all(void) const noexcept;
+    bool any(void) const noexcept;
+    // Throws std::runtime_error if flag is out of range
+    constexpr enum_bitset& clear(T p_flag);
+
+    // Method for counting set flags
+    //
+    // Returns:
+    //   number of set flags
+    std::size_t count(void) const noexcept;
+
+    // Method for visiting set flags in ascending order, skipping unset flags
+    //
+    // Parameters:
+    //   p_callable - callable invoked with every set flag
+    template<class Callable>
+    void for_each(Callable&& p_callable) const;
+
+    bool none(void) const noexcept;
+    // Throws std::runtime_error if flag is out of range
+    constexpr enum_bitset& set(T p_flag);
+    static constexpr std::size_t size(void) noexcept;
+    // Throws std::runtime_error if flag is out of range
+    constexpr bool test(T p_flag) const;
+
+    // Method for checking whether all given flags are set (whether given set is subset)
+    //
+    // Parameters:
+    //   p_flags - flags to check
+    //
+    // Returns:
+    //   true if all given flags are set
+    bool test(const enum_bitset& p_flags) const noexcept;
+
+    // Method for checking whether any of given flags is set (whether sets intersect)
+    //
+    // Parameters:
+    //   p_flags - flags to check
+    //
+    // Returns:
+    //   true if any of given flags is set
+    bool test_any(const enum_bitset& p_flags) const noexcept;
+
+    // Throws std::runtime_error if flag is out of range
+    constexpr enum_bitset& toggle(T p_flag);
+
+  private:
+    static constexpr std::size_t _index(T p_flag);
+
+  private:
+    // Words are padded to whole 128-bit vectors, with bits beyond N kept unset
+    static constexpr std::size_t s_words = (N + 127) / 128 * 2;
+
+  private:
+    alignas(16) uint64_t m_words[s_words]{};
+  };
 #pragma endregion
 
 #pragma region IMPLEMENTATION
@@ -93,5 +286,476 @@ namespace flib
   {
     return (p_value & p_flag) == p_flag;
   }
+
+  // Index of single set bit, or -1 if there is not exactly one set bit
+  inline constexpr int _flag_index(uint64_t p_bits)
+  {
+    if (0 == p_bits || 0 != (p_bits & (p_bits - 1)))
+    {
+      return -1;
+    }
+    auto index = 0;
+    for (; 1 != p_bits; p_bits >>= 1)
+    {
+      ++index;
+    }
+    return index;
+  }
+
+  template<class T>
+  inline constexpr flag_set<T>::flag_set(T p_flags) noexcept
+    : m_flags(static_cast<_bits_t>(p_flags))
+  {
+  }
+
+  template<class T>
+  inline constexpr bool flag_set<T>::operator==(flag_set p_other) const noexcept
+  {
+    return m_flags == p_other.m_flags;
+  }
+
+  template<class T>
+  inline constexpr bool flag_set<T>::operator!=(flag_set p_other) const noexcept
+  {
+    return m_flags != p_other.m_flags;
+  }
+
+  template<class T>
+  inline constexpr flag_set<T> flag_set<T>::operator~(void) const noexcept
+  {
+    return static_cast<T>(static_cast<_bits_t>(~m_flags));
+  }
+
+  template<class T>
+  inline constexpr flag_set<T> flag_set<T>::operator&(flag_set p_other) const noexcept
+  {
+    return static_cast<T>(static_cast<_bits_t>(m_flags & p_other.m_flags));
+  }
+
+  template<class T>
+  inline constexpr flag_set<T> flag_set<T>::operator|(flag_set p_other) const noexcept
+  {
+    return static_cast<T>(static_cast<_bits_t>(m_flags | p_other.m_flags));
+  }
+
+  template<class T>
+  inline constexpr flag_set<T> flag_set<T>::operator^(flag_set p_other) const noexcept
+  {
+    return static_cast<T>(static_cast<_bits_t>(m_flags ^ p_other.m_flags));
+  }
+
+  template<class T>
+  inline constexpr flag_set<T>& flag_set<T>::operator&=(flag_set p_other) noexcept
+  {
+    m_flags = static_cast<_bits_t>(m_flags & p_other.m_flags);
+    return *this;
+  }
+
+  template<class T>
+  inline constexpr flag_set<T>& flag_set<T>::operator|=(flag_set p_other) noexcept
+  {
+    m_flags = static_cast<_bits_t>(m_flags | p_other.m_flags);
+    return *this;
+  }
+
+  template<class T>
+  inline constexpr flag_set<T>& flag_set<T>::operator^=(flag_set p_other) noexcept
+  {
+    m_flags = static_cast<_bits_t>(m_flags ^ p_other.m_flags);
+    return *this;
+  }
+
+  template<class T>
+  inline constexpr bool flag_set<T>::any(void) const noexcept
+  {
+    return 0 != m_flags;
+  }
+
+  template<class T>
+  inline constexpr flag_set<T>& flag_set<T>::clear(flag_set p_flags) noexcept
+  {
+    m_flags = static_cast<_bits_t>(m_flags & ~p_flags.m_flags);
+    return *this;
+  }
+
+  template<class T>
+  inline std::size_t flag_set<T>::count(void) const noexcept
+  {
+    return popcount(m_flags);
+  }
+
+  template<class T>
+  template<class Callable>
+  inline void flag_set<T>::for_each(Callable&& p_callable) const
+  {
+    for (uint64_t bits = m_flags; 0 != bits; bits &= bits - 1)
+    {
+      p_callable(static_cast<T>(static_cast<_bits_t>(uint64_t{ 1 } << countr_zero(bits))));
+    }
+  }
+
+  template<class T>
+  inline constexpr bool flag_set<T>::none(void) const noexcept
+  {
+    return 0 == m_flags;
+  }
+
+  template<class T>
+  inline constexpr flag_set<T>& flag_set<T>::set(flag_set p_flags) noexcept
+  {
+    m_flags = static_cast<_bits_t>(m_flags | p_flags.m_flags);
+    return *this;
+  }
+
+  template<class T>
+  inline constexpr bool flag_set<T>::test(flag_set p_flags) const noexcept
+  {
+    return (m_flags & p_flags.m_flags) == p_flags.m_flags;
+  }
+
+  template<class T>
+  inline constexpr flag_set<T>& flag_set<T>::toggle(flag_set p_flags) noexcept
+  {
+    m_flags = static_cast<_bits_t>(m_flags ^ p_flags.m_flags);
+    return *this;
+  }
+
+  template<class T>
+  inline constexpr T flag_set<T>::value(void) const noexcept
+  {
+    return static_cast<T>(m_flags);
+  }
+
+  template<class T, class Value>
+  inline constexpr flag_map<T, Value>::flag_map(std::initializer_list<std::pair<T, Value>> p_entries)
+  {
+    m_shifted = true;
+    auto first = true;
+    for (auto& entry : p_entries)
+    {
+      auto flag = static_cast<_bits_t>(entry.first);
+      auto index = _flag_index(flag);
+      if (index < 0)
+      {
+        throw std::runtime_error("Flag map entry is not single flag");
+      }
+      for (auto combination = 0; combination < 16; ++combination)
+      {
+        if (0 != (combination >> index % 4 & 1))
+        {
+          m_values[index / 4][combination] = static_cast<Value>(m_values[index / 4][combination] | entry.second);
+        }
+      }
+      m_mapped = static_cast<_bits_t>(m_mapped | flag);
+      auto value_index = _flag_index(static_cast<typename std::make_unsigned<Value>::type>(entry.second));
+      if (first)
+      {
+        m_shift = value_index - index;
+        first = false;
+      }
+      m_shifted = m_shifted & (value_index >= 0) & (value_index - index == m_shift);
+    }
+  }
+
+  template<class T, class Value>
+  inline Value flag_map<T, Value>::translate(flag_set<T> p_flags) const noexcept
+  {
+    uint64_t bits = static_cast<_bits_t>(p_flags.value()) & m_mapped;
+    if (m_shifted)
+    {
+      return static_cast<Value>(m_shift < 0 ? bits >> -m_shift : bits << m_shift);
+    }
+    Value result{};
+    for (auto values = m_values; 0 != bits; bits >>= 4, ++values)
+    {
+      result = static_cast<Value>(result | (*values)[bits & 0x0f]);
+    }
+    return result;
+  }
+
+  template<class T, std::size_t N>
+  inline constexpr enum_bitset<T, N>::enum_bitset(std::initializer_list<T> p_flags)
+  {
+    for (auto flag : p_flags)
+    {
+      set(flag);
+    }
+  }
+
+  template<class T, std::size_t N>
+  inline bool enum_bitset<T, N>::operator==(const enum_bitset& p_other) const noexcept
+  {
+#if defined(FLIB_SSE2)
+    auto difference = _mm_setzero_si128();
+    for (std::size_t i = 0; i < s_words; i += 2)
+    {
+      difference = _mm_or_si128(difference, _mm_xor_si128(_mm_load_si128(reinterpret_cast<const __m128i*>(m_words + i)),
+        _mm_load_si128(reinterpret_cast<const __m128i*>(p_other.m_words + i))));
+    }
+    return 0xffff == _mm_movemask_epi8(_mm_cmpeq_epi8(difference, _mm_setzero_si128()));
+#else
+    uint64_t difference = 0;
+    for (std::size_t i = 0; i < s_words; ++i)
+    {
+      difference |= m_words[i] ^ p_other.m_words[i];
+    }
+    return 0 == difference;
+#endif
+  }
+
+  template<class T, std::size_t N>
+  inline bool enum_bitset<T, N>::operator!=(const enum_bitset& p_other) const noexcept
+  {
+    return !(*this == p_other);
+  }
+
+  template<class T, std::size_t N>
+  inline enum_bitset<T, N> enum_bitset<T, N>::operator~(void) const noexcept
+  {
+    auto result = *this;
+    for (auto& word : result.m_words)
+    {
+      word = ~word;
+    }
+    // Bits beyond N are unset again
+    if (0 != N % 64)
+    {
+      result.m_words[N / 64] &= (uint64_t{ 1 } << N % 64) - 1;
+    }
+    for (auto i = (N + 63) / 64; i < s_words; ++i)
+    {
+      result.m_words[i] = 0;
+    }
+    return result;
+  }
+
+  template<class T, std::size_t N>
+  inline enum_bitset<T, N> enum_bitset<T, N>::operator&(const enum_bitset& p_other) const noexcept
+  {
+    auto result = *this;
+    result &= p_other;
+    return result;
+  }
+
+  template<class T, std::size_t N>
+  inline enum_bitset<T, N> enum_bitset<T, N>::operator|(const enum_bitset& p_other) const noexcept
+  {
+    auto result = *this;
+    result |= p_other;
+    return result;
+  }
+
+  template<class T, std::size_t N>
+  inline enum_bitset<T, N> enum_bitset<T, N>::operator^(const enum_bitset& p_other) const noexcept
+  {
+    auto result = *this;
+    result ^= p_other;
+    return result;
+  }
+
+  template<class T, std::size_t N>
+  inline enum_bitset<T, N>& enum_bitset<T, N>::operator&=(const enum_bitset& p_other) noexcept
+  {
+#if defined(FLIB_SSE2)
+    for (std::size_t i = 0; i < s_words; i += 2)
+    {
+      _mm_store_si128(reinterpret_cast<__m128i*>(m_words + i), _mm_and_si128(
+        _mm_load_si128(reinterpret_cast<const __m128i*>(m_words + i)),
+        _mm_load_si128(reinterpret_cast<const __m128i*>(p_other.m_words + i))));
+    }
+#else
+    for (std::size_t i = 0; i < s_words; ++i)
+    {
+      m_words[i] &= p_other.m_words[i];
+    }
+#endif
+    return *this;
+  }
+
+  template<class T, std::size_t N>
+  inline enum_bitset<T, N>& enum_bitset<T, N>::operator|=(const enum_bitset& p_other) noexcept
+  {
+#if defined(FLIB_SSE2)
+    for (std::size_t i = 0; i < s_words; i += 2)
+    {
+      _mm_store_si128(reinterpret_cast<__m128i*>(m_words + i), _mm_or_si128(
+        _mm_load_si128(reinterpret_cast<const __m128i*>(m_words + i)),
+        _mm_load_si128(reinterpret_cast<const __m128i*>(p_other.m_words + i))));
+    }
+#else
+    for (std::size_t i = 0; i < s_words; ++i)
+    {
+      m_words[i] |= p_other.m_words[i];
+    }
+#endif
+    return *this;
+  }
+
+  template<class T, std::size_t N>
+  inline enum_bitset<T, N>& enum_bitset<T, N>::operator^=(const enum_bitset& p_other) noexcept
+  {
+#if defined(FLIB_SSE2)
+    for (std::size_t i = 0; i < s_words; i += 2)
+    {
+      _mm_store_si128(reinterpret_cast<__m128i*>(m_words + i), _mm_xor_si128(
+        _mm_load_si128(reinterpret_cast<const __m128i*>(m_words + i)),
+        _mm_load_si128(reinterpret_cast<const __m128i*>(p_other.m_words + i))));
+    }
+#else
+    for (std::size_t i = 0; i < s_words; ++i)
+    {
+      m_words[i] ^= p_other.m_words[i];
+    }
+#endif
+    return *this;
+  }
+
+  template<class T, std::size_t N>
+  inline bool enum_bitset<T, N>::all(void) const noexcept
+  {
+    return (~*this).none();
+  }
+
+  template<class T, std::size_t N>
+  inline bool enum_bitset<T, N>::any(void) const noexcept
+  {
+    return !none();
+  }
+
+  template<class T, std::size_t N>
+  inline constexpr enum_bitset<T, N>& enum_bitset<T, N>::clear(T p_flag)
+  {
+    auto index = _index(p_flag);
+    m_words[index / 64] &= ~(uint64_t{ 1 } << index % 64);
+    return *this;
+  }
+
+  template<class T, std::size_t N>
+  inline std::size_t enum_bitset<T, N>::count(void) const noexcept
+  {
+    std::size_t result = 0;
+    for (auto word : m_words)
+    {
+      result += popcount(word);
+    }
+    return result;
+  }
+
+  template<class T, std::size_t N>
+  template<class Callable>
+  inline void enum_bitset<T, N>::for_each(Callable&& p_callable) const
+  {
+    for (std::size_t i = 0; i < s_words; ++i)
+    {
+      for (auto bits = m_words[i]; 0 != bits; bits &= bits - 1)
+      {
+        p_callable(static_cast<T>(i * 64 + countr_zero(bits)));
+      }
+    }
+  }
+
+  template<class T, std::size_t N>
+  inline bool enum_bitset<T, N>::none(void) const noexcept
+  {
+#if defined(FLIB_SSE2)
+    auto bits = _mm_setzero_si128();
+    for (std::size_t i = 0; i < s_words; i += 2)
+    {
+      bits = _mm_or_si128(bits, _mm_load_si128(reinterpret_cast<const __m128i*>(m_words + i)));
+    }
+    return 0xffff == _mm_movemask_epi8(_mm_cmpeq_epi8(bits, _mm_setzero_si128()));
+#else
+    uint64_t bits = 0;
+    for (auto word : m_words)
+    {
+      bits |= word;
+    }
+    return 0 == bits;
+#endif
+  }
+
+  template<class T, std::size_t N>
+  inline constexpr enum_bitset<T, N>& enum_bitset<T, N>::set(T p_flag)
+  {
+    auto index = _index(p_flag);
+    m_words[index / 64] |= uint64_t{ 1 } << index % 64;
+    return *this;
+  }
+
+  template<class T, std::size_t N>
+  inline constexpr std::size_t enum_bitset<T, N>::size(void) noexcept
+  {
+    return N;
+  }
+
+  template<class T, std::size_t N>
+  inline constexpr bool enum_bitset<T, N>::test(T p_flag) const
+  {
+    auto index = _index(p_flag);
+    return 0 != (m_words[index / 64] >> index % 64 & 1);
+  }
+
+  template<class T, std::size_t N>
+  inline bool enum_bitset<T, N>::test(const enum_bitset& p_flags) const noexcept
+  {
+#if defined(FLIB_SSE2)
+    auto missing = _mm_setzero_si128();
+    for (std::size_t i = 0; i < s_words; i += 2)
+    {
+      missing = _mm_or_si128(missing, _mm_andnot_si128(_mm_load_si128(reinterpret_cast<const __m128i*>(m_words + i)),
+        _mm_load_si128(reinterpret_cast<const __m128i*>(p_flags.m_words + i))));
+    }
+    return 0xffff == _mm_movemask_epi8(_mm_cmpeq_epi8(missing, _mm_setzero_si128()));
+#else
+    uint64_t missing = 0;
+    for (std::size_t i = 0; i < s_words; ++i)
+    {
+      missing |= p_flags.m_words[i] & ~m_words[i];
+    }
+    return 0 == missing;
+#endif
+  }
+
+  template<class T, std::size_t N>
+  inline bool enum_bitset<T, N>::test_any(const enum_bitset& p_flags) const noexcept
+  {
+#if defined(FLIB_SSE2)
+    auto common = _mm_setzero_si128();
+    for (std::size_t i = 0; i < s_words; i += 2)
+    {
+      common = _mm_or_si128(common, _mm_and_si128(_mm_load_si128(reinterpret_cast<const __m128i*>(m_words + i)),
+        _mm_load_si128(reinterpret_cast<const __m128i*>(p_flags.m_words + i))));
+    }
+    return 0xffff != _mm_movemask_epi8(_mm_cmpeq_epi8(common, _mm_setzero_si128()));
+#else
+    uint64_t common = 0;
+    for (std::size_t i = 0; i < s_words; ++i)
+    {
+      common |= m_words[i] & p_flags.m_words[i];
+    }
+    return 0 != common;
+#endif
+  }
+
+  template<class T, std::size_t N>
+  inline constexpr enum_bitset<T, N>& enum_bitset<T, N>::toggle(T p_flag)
+  {
+    auto index = _index(p_flag);
+    m_words[index / 64] ^= uint64_t{ 1 } << index % 64;
+    return *this;
+  }
+
+  template<class T, std::size_t N>
+  inline constexpr std::size_t enum_bitset<T, N>::_index(T p_flag)
+  {
+    // Negative values are converted to out of range indices
+    auto index = static_cast<std::size_t>(static_cast<typename std::make_unsigned<
+      typename std::underlying_type<T>::type>::type>(p_flag));
+    if (index >= N)
+    {
+      throw std::runtime_error("Flag is out of bitset range");
+    }
+    return index;
+  }
 #pragma endregion
 }
\ No newline at end of file
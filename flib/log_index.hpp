@@ -0,0 +1,361 @@
+// Copyright © 2024 Luka Arnecic.
+// See the LICENSE file at the top-level directory of this distribution.
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <flib/timestamp.hpp>
+
+#if defined(_WIN32)
+#  define WIN32_LEAN_AND_MEAN
+#  include <windows.h>
+#elif defined(__linux__)
+#  include <cerrno>
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+namespace flib
+{
+#pragma region API
+  // Sparse timestamp index of memory-mapped log file, whose lines start with timestamps (optionally enclosed in square
+  // brackets) in chronological order. Lines without timestamp (e.g. multi-line messages) belong to preceding line.
+  //
+  // Index samples first timestamped line after every stride bytes, while queries bisect the mapping between samples,
+  // so that only pages around sampled and bisected lines are read.
+  class log_index
+  {
+  public:
+    using time_point_t = std::chrono::system_clock::time_point;
+
+    // Byte range [begin, end) of file
+    struct range_t
+    {
+      std::size_t begin;
+      std::size_t end;
+    };
+
+    static constexpr std::size_t s_default_stride = 1u << 20;
+
+  public:
+    log_index(void) = default;
+    explicit log_index(const std::string& p_filepath, std::size_t p_stride = s_default_stride);
+    log_index(const log_index&) = delete;
+    log_index(log_index&&) = delete;
+    ~log_index(void) noexcept;
+    log_index& operator=(const log_index&) = delete;
+    log_index& operator=(log_index&&) = delete;
+    void close(void) noexcept;
+    const char* data(void) const noexcept;
+
+    // Method for finding byte range of lines with timestamps within time window
+    //
+    // Parameters:
+    //   p_begin - Time window start (inclusive)
+    //   p_end   - Time window end (exclusive)
+    //
+    // Returns:
+    //   byte range of lines (including trailing lines without timestamp)
+    range_t find(const time_point_t& p_begin, const time_point_t& p_end) const;
+
+    // Method for finding offset of first line with timestamp not earlier than given time point
+    //
+    // Parameters:
+    //   p_timepoint - Searched time point
+    //
+    // Returns:
+    //   byte offset of line or file size if there is no such line
+    std::size_t lower_bound(const time_point_t& p_timepoint) const;
+    void open(const std::string& p_filepath, std::size_t p_stride = s_default_stride);
+    bool opened(void) const noexcept;
+    std::size_t samples(void) const noexcept;
+    std::size_t size(void) const noexcept;
+
+  private:
+    struct _sample_t
+    {
+      time_point_t m_timepoint;
+      std::size_t m_offset;
+    };
+
+    static constexpr std::size_t s_scan_limit = 4096;
+
+  private:
+    void _build(std::size_t p_stride);
+    std::size_t _first_timestamped(std::size_t p_start, std::size_t p_limit, time_point_t& p_timepoint) const noexcept;
+    void _map(const std::string& p_filepath);
+    std::size_t _next_line(std::size_t p_offset) const noexcept;
+    bool _read_timestamp(std::size_t p_offset, time_point_t& p_timepoint) const noexcept;
+    void _unmap(void) noexcept;
+
+  private:
+#if defined(_WIN32)
+    HANDLE m_file_win{ INVALID_HANDLE_VALUE };
+    HANDLE m_mapping_win{ NULL };
+#endif
+    const char* m_data{ nullptr };
+    std::size_t m_size{ 0 };
+    bool m_opened{ false };
+    std::vector<_sample_t> m_samples;
+  };
+#pragma endregion
+
+#pragma region IMPLEMENTATION
+  inline log_index::log_index(const std::string& p_filepath, std::size_t p_stride)
+  {
+    open(p_filepath, p_stride);
+  }
+
+  inline log_index::~log_index(void) noexcept
+  {
+    close();
+  }
+
+  inline void log_index::close(void) noexcept
+  {
+    _unmap();
+    m_samples.clear();
+    m_opened = false;
+  }
+
+  inline const char* log_index::data(void) const noexcept
+  {
+    return m_data;
+  }
+
+  inline log_index::range_t log_index::find(const time_point_t& p_begin, const time_point_t& p_end) const
+  {
+    auto begin = lower_bound(p_begin);
+    auto end = p_begin < p_end ? lower_bound(p_end) : begin;
+    return { begin, end };
+  }
+
+  inline std::size_t log_index::lower_bound(const time_point_t& p_timepoint) const
+  {
+    if (!opened())
+    {
+      throw std::runtime_error("Log index not opened");
+    }
+    auto sample = std::lower_bound(m_samples.begin(), m_samples.end(), p_timepoint,
+      [](const _sample_t& p_sample, const time_point_t& p_value)
+      {
+        return p_sample.m_timepoint < p_value;
+      });
+    if (m_samples.begin() == sample)
+    {
+      return m_samples.empty() ? m_size : sample->m_offset;
+    }
+    // Line at low is earlier than searched time point, while line at high is not (or is end of file)
+    auto low = std::prev(sample)->m_offset;
+    auto high = m_samples.end() == sample ? m_size : sample->m_offset;
+    time_point_t timepoint;
+    while (high - low > s_scan_limit)
+    {
+      auto middle = _first_timestamped(_next_line(low + (high - low) / 2), high, timepoint);
+      if (high == middle)
+      {
+        break;
+      }
+      (timepoint < p_timepoint ? low : high) = middle;
+    }
+    for (auto offset = _next_line(low); offset < high; offset = _next_line(offset))
+    {
+      if (_read_timestamp(offset, timepoint) && !(timepoint < p_timepoint))
+      {
+        return offset;
+      }
+    }
+    return high;
+  }
+
+  inline void log_index::open(const std::string& p_filepath, std::size_t p_stride)
+  {
+    if (opened())
+    {
+      throw std::runtime_error("Log index already opened");
+    }
+    if (0 == p_stride)
+    {
+      p_stride = s_default_stride;
+    }
+    _map(p_filepath);
+    try
+    {
+      _build(p_stride);
+    }
+    catch (...)
+    {
+      _unmap();
+      throw;
+    }
+    m_opened = true;
+  }
+
+  inline bool log_index::opened(void) const noexcept
+  {
+    return m_opened;
+  }
+
+  inline std::size_t log_index::samples(void) const noexcept
+  {
+    return m_samples.size();
+  }
+
+  inline std::size_t log_index::size(void) const noexcept
+  {
+    return m_size;
+  }
+
+  inline void log_index::_build(std::size_t p_stride)
+  {
+    m_samples.clear();
+    m_samples.reserve(m_size / p_stride + 1);
+    for (std::size_t start = 0; start < m_size;)
+    {
+      _sample_t sample{};
+      auto limit = m_size - start > p_stride ? start + p_stride : m_size;
+      sample.m_offset = _first_timestamped(start, limit, sample.m_timepoint);
+      if (limit != sample.m_offset)
+      {
+        if (!m_samples.empty() && sample.m_timepoint < m_samples.back().m_timepoint)
+        {
+          throw std::runtime_error("Log timestamps not in chronological order");
+        }
+        m_samples.push_back(sample);
+      }
+      start = limit < m_size ? _next_line(limit - 1) : m_size;
+    }
+  }
+
+  inline std::size_t log_index::_first_timestamped(std::size_t p_start, std::size_t p_limit,
+    time_point_t& p_timepoint) const noexcept
+  {
+    for (; p_start < p_limit; p_start = _next_line(p_start))
+    {
+      if (_read_timestamp(p_start, p_timepoint))
+      {
+        return p_start;
+      }
+    }
+    return p_limit;
+  }
+
+  inline void log_index::_map(const std::string& p_filepath)
+  {
+#if defined(_WIN32)
+    m_file_win = ::CreateFileA(p_filepath.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING,
+      FILE_FLAG_RANDOM_ACCESS, NULL);
+    LARGE_INTEGER size{};
+    if (INVALID_HANDLE_VALUE == m_file_win || !::GetFileSizeEx(m_file_win, &size))
+    {
+      auto error = ::GetLastError();
+      _unmap();
+      throw std::runtime_error("Log file opening failed (code: " + std::to_string(error) + ")");
+    }
+    m_size = static_cast<std::size_t>(size.QuadPart);
+    if (0 == m_size)
+    {
+      return;
+    }
+    m_mapping_win = ::CreateFileMappingA(m_file_win, NULL, PAGE_READONLY, 0, 0, NULL);
+    m_data = NULL == m_mapping_win ? nullptr :
+      static_cast<const char*>(::MapViewOfFile(m_mapping_win, FILE_MAP_READ, 0, 0, 0));
+    if (nullptr == m_data)
+    {
+      auto error = ::GetLastError();
+      _unmap();
+      throw std::runtime_error("Log file mapping failed (code: " + std::to_string(error) + ")");
+    }
+#elif defined(__linux__)
+    auto file = ::open(p_filepath.c_str(), O_RDONLY | O_CLOEXEC);
+    struct stat status{};
+    if (-1 == file || -1 == ::fstat(file, &status))
+    {
+      auto error = errno;
+      if (-1 != file)
+      {
+        ::close(file);
+      }
+      throw std::runtime_error("Log file opening failed (code: " + std::to_string(error) + ")");
+    }
+    m_size = static_cast<std::size_t>(status.st_size);
+    if (0 == m_size)
+    {
+      ::close(file);
+      return;
+    }
+    auto data = ::mmap(nullptr, m_size, PROT_READ, MAP_SHARED, file, 0);
+    auto error = errno;
+    ::close(file);
+    if (MAP_FAILED == data)
+    {
+      m_size = 0;
+      throw std::runtime_error("Log file mapping failed (code: " + std::to_string(error) + ")");
+    }
+    // Disable read-ahead, as only sampled and bisected lines are read
+    ::madvise(data, m_size, MADV_RANDOM);
+    m_data = static_cast<const char*>(data);
+#else
+#  error "Unsupported platform/compiler"
+#endif
+  }
+
+  inline std::size_t log_index::_next_line(std::size_t p_offset) const noexcept
+  {
+    auto line_end = static_cast<const char*>(std::memchr(m_data + p_offset, '\n', m_size - p_offset));
+    return nullptr == line_end ? m_size : static_cast<std::size_t>(line_end - m_data) + 1;
+  }
+
+  inline bool log_index::_read_timestamp(std::size_t p_offset, time_point_t& p_timepoint) const noexcept
+  {
+    auto start = m_data + p_offset;
+    auto end = m_data + m_size;
+    start += end != start && '[' == *start ? 1 : 0;
+    auto limit = static_cast<std::size_t>(end - start) < max_parse_length ? end : start + max_parse_length;
+    auto it = start;
+    while (limit != it && ' ' != *it && '\t' != *it && ']' != *it && '\r' != *it && '\n' != *it)
+    {
+      ++it;
+    }
+    return parse_status_t::ok == parse(start, static_cast<std::size_t>(it - start), p_timepoint);
+  }
+
+  inline void log_index::_unmap(void) noexcept
+  {
+#if defined(_WIN32)
+    if (nullptr != m_data)
+    {
+      ::UnmapViewOfFile(m_data);
+    }
+    if (NULL != m_mapping_win)
+    {
+      ::CloseHandle(m_mapping_win);
+    }
+    if (INVALID_HANDLE_VALUE != m_file_win)
+    {
+      ::CloseHandle(m_file_win);
+    }
+    m_mapping_win = NULL;
+    m_file_win = INVALID_HANDLE_VALUE;
+#elif defined(__linux__)
+    if (nullptr != m_data)
+    {
+      ::munmap(const_cast<char*>(m_data), m_size);
+    }
+#endif
+    m_data = nullptr;
+    m_size = 0;
+  }
+#pragma endregion
+}
\ No newline at end of file
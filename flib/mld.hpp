@@ -5,6 +5,8 @@
 
 #include <cstdint>
 
+#include <flib/flags.hpp>
+
 #if !defined(FLIB_NO_MEMORY_LEAK_DETECTION) & defined(_DEBUG) & defined(_MSC_VER)
 #  define FLIB_MEMORY_LEAK_DETECTION
 #  define _CRTDBG_MAP_ALLOC
@@ -15,8 +17,6 @@
 #  endif
 #endif
 
-#include <flib/flags.hpp>
-
 namespace flib
 {
 #pragma region API
@@ -70,44 +70,18 @@ namespace flib
 
   inline void memory_leak_detector::setup(flags p_flags)
   {
-    int internal_flags = 0;
-    if (flib::is_flag_set(p_flags, flags::debug_heap_allocations))
-    {
-      internal_flags |= _CRTDBG_ALLOC_MEM_DF;
-    }
-    if (flib::is_flag_set(p_flags, flags::delay_free_memory))
-    {
-      internal_flags |= _CRTDBG_DELAY_FREE_MEM_DF;
-    }
-    if (flib::is_flag_set(p_flags, flags::exit_leak_check))
-    {
-      internal_flags |= _CRTDBG_LEAK_CHECK_DF;
-    }
-    if (flib::is_flag_set(p_flags, flags::check_crt_types))
-    {
-      internal_flags |= _CRTDBG_CHECK_CRT_DF;
-    }
-    if (flib::is_flag_set(p_flags, flags::check_manual))
-    {
-      internal_flags |= _CRTDBG_CHECK_DEFAULT_DF;
-    }
-    if (flib::is_flag_set(p_flags, flags::check_every_16))
-    {
-      internal_flags |= _CRTDBG_CHECK_EVERY_16_DF;
-    }
-    if (flib::is_flag_set(p_flags, flags::check_every_128))
-    {
-      internal_flags |= _CRTDBG_CHECK_EVERY_128_DF;
-    }
-    if (flib::is_flag_set(p_flags, flags::check_every_1024))
-    {
-      internal_flags |= _CRTDBG_CHECK_EVERY_1024_DF;
-    }
-    if (flib::is_flag_set(p_flags, flags::check_always))
-    {
-      internal_flags |= _CRTDBG_CHECK_ALWAYS_DF;
-    }
-    _CrtSetDbgFlag(internal_flags);
+    static constexpr flag_map<flags, int> internal_flags{
+      { flags::debug_heap_allocations, _CRTDBG_ALLOC_MEM_DF },
+      { flags::delay_free_memory, _CRTDBG_DELAY_FREE_MEM_DF },
+      { flags::exit_leak_check, _CRTDBG_LEAK_CHECK_DF },
+      { flags::check_crt_types, _CRTDBG_CHECK_CRT_DF },
+      { flags::check_manual, _CRTDBG_CHECK_DEFAULT_DF },
+      { flags::check_every_16, _CRTDBG_CHECK_EVERY_16_DF },
+      { flags::check_every_128, _CRTDBG_CHECK_EVERY_128_DF },
+      { flags::check_every_1024, _CRTDBG_CHECK_EVERY_1024_DF },
+      { flags::check_always, _CRTDBG_CHECK_ALWAYS_DF }
+    };
+    _CrtSetDbgFlag(internal_flags.translate(p_flags));
     _CrtSetReportMode(_CRT_WARN, _CRTDBG_MODE_FILE | _CRTDBG_MODE_DEBUG);
     _CrtSetReportFile(_CRT_WARN, _CRTDBG_FILE_STDOUT);
     _CrtSetReportMode(_CRT_ERROR, _CRTDBG_MODE_FILE | _CRTDBG_MODE_DEBUG);
@@ -0,0 +1,767 @@
+// Copyright © 2024 Luka Arnecic.
+// See the LICENSE file at the top-level directory of this distribution.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+#if defined(_MSC_VER) & (defined(_M_X64) | defined(_M_ARM64))
+#  include <intrin.h>
+#endif
+
+#if defined(__linux__)
+#  include <cerrno>
+#  include <sys/random.h>
+#endif
+
+#if defined(__unix__) | defined(__APPLE__)
+#  include <pthread.h>
+#endif
+
+#if !defined(FLIB_NO_SSE2) & (defined(__SSE2__) | defined(_M_X64))
+#  define FLIB_SSE2
+#  include <emmintrin.h>
+#endif
+
+namespace flib
+{
+#pragma region API
+  // Optional macros:
+  //  - FLIB_NO_SSE2 ... disables use of SSE2 instructions in ChaCha20 block function of chacha20 and secure_generator
+  //
+  // SSE2 instructions are used when enabled for compilation (default for x86-64), otherwise blocks are computed with
+  // portable 32-bit word operations
+
+  // Small-state pseudo-random generators satisfying UniformRandomBitGenerator requirements (not cryptographically
+  // secure). Integer seeds are expanded with splitmix64.
+
+  // xoshiro256** generator (256-bit state, period 2^256 - 1)
+  // Refer to: https://prng.di.unimi.it/
+  class xoshiro256ss
+  {
+  public:
+    using result_type = uint64_t;
+
+    static constexpr uint64_t s_default_seed = 0x853c49e6748fea9bull;
+
+  public:
+    xoshiro256ss(void) noexcept;
+    explicit xoshiro256ss(uint64_t p_seed) noexcept;
+    explicit xoshiro256ss(std::seed_seq& p_sequence);
+    bool operator==(const xoshiro256ss& p_other) const noexcept;
+    bool operator!=(const xoshiro256ss& p_other) const noexcept;
+    result_type operator()(void) noexcept;
+    void discard(unsigned long long p_count) noexcept;
+
+    // Method for advancing generator by 2^128 steps, used for generation of 2^128 non-overlapping sequences (e.g. one
+    // per thread)
+    void jump(void) noexcept;
+
+    // Method for advancing generator by 2^192 steps, used for generation of 2^64 starting points, from each of which
+    // jump generates 2^64 non-overlapping sequences
+    void long_jump(void) noexcept;
+    void seed(uint64_t p_seed) noexcept;
+    void seed(std::seed_seq& p_sequence);
+    static constexpr result_type max(void) noexcept;
+    static constexpr result_type min(void) noexcept;
+
+  private:
+    void _jump(const uint64_t (&p_polynomial)[4]) noexcept;
+    static uint64_t _rotate_left(uint64_t p_value, int p_shift) noexcept;
+
+  private:
+    uint64_t m_state[4];
+  };
+
+  // wyrand generator (64-bit state, period 2^64), with constant-time discard
+  // Refer to: https://github.com/wangyi-fudan/wyhash
+  class wyrand
+  {
+  public:
+    using result_type = uint64_t;
+
+    static constexpr uint64_t s_default_seed = 0x853c49e6748fea9bull;
+
+  public:
+    wyrand(void) noexcept;
+    explicit wyrand(uint64_t p_seed) noexcept;
+    explicit wyrand(std::seed_seq& p_sequence);
+    bool operator==(const wyrand& p_other) const noexcept;
+    bool operator!=(const wyrand& p_other) const noexcept;
+    result_type operator()(void) noexcept;
+    void discard(unsigned long long p_count) noexcept;
+    void seed(uint64_t p_seed) noexcept;
+    void seed(std::seed_seq& p_sequence);
+    static constexpr result_type max(void) noexcept;
+    static constexpr result_type min(void) noexcept;
+
+  private:
+    uint64_t m_state;
+  };
+
+  // ChaCha20 generator (RFC 8439 block function with 64-bit block counter and 64-bit stream id, i.e. original
+  // variant), producing keystream words in their little-endian order, with constant-time discard
+  class chacha20
+  {
+  public:
+    using result_type = uint64_t;
+
+    static constexpr uint64_t s_default_seed = 0x853c49e6748fea9bull;
+
+  public:
+    chacha20(void) noexcept;
+    explicit chacha20(uint64_t p_seed) noexcept;
+    explicit chacha20(std::seed_seq& p_sequence);
+    chacha20(const uint32_t (&p_key)[8], uint64_t p_stream, uint64_t p_counter = 0) noexcept;
+    bool operator==(const chacha20& p_other) const noexcept;
+    bool operator!=(const chacha20& p_other) const noexcept;
+    result_type operator()(void) noexcept;
+    void discard(unsigned long long p_count) noexcept;
+    void seed(uint64_t p_seed) noexcept;
+    void seed(std::seed_seq& p_sequence);
+
+    // Method for seeding generator with key, stream id and starting block counter
+    //
+    // Parameters:
+    //   p_key     - 256-bit key as 8 little-endian words
+    //   p_stream  - Stream id (nonce)
+    //   p_counter - Block counter of first block
+    void seed(const uint32_t (&p_key)[8], uint64_t p_stream, uint64_t p_counter = 0) noexcept;
+    static constexpr result_type max(void) noexcept;
+    static constexpr result_type min(void) noexcept;
+
+  private:
+    static constexpr std::size_t s_buffer_size = 128;
+
+  private:
+    void _refill(void) noexcept;
+
+  private:
+    uint32_t m_key[8];
+    uint64_t m_stream;
+    uint64_t m_counter;
+    std::size_t m_position;
+    uint32_t m_buffer[2 * s_buffer_size];
+  };
+
+  // Cryptographically secure generator, seeded from operating system (getrandom on linux, std::random_device
+  // elsewhere)
+  //
+  // Output is ChaCha20 keystream served from buffer, whose first 256 bits are used as key of next buffer (fast key
+  // erasure), so that past outputs cannot be reconstructed from generator state. Generator is reseeded from operating
+  // system periodically and in child process after fork. It is not copyable, so that its output is never duplicated.
+  class secure_generator
+  {
+  public:
+    using result_type = uint64_t;
+
+  public:
+    secure_generator(void);
+    secure_generator(const secure_generator&) = delete;
+    secure_generator(secure_generator&&) = delete;
+    ~secure_generator(void) noexcept;
+    secure_generator& operator=(const secure_generator&) = delete;
+    secure_generator& operator=(secure_generator&&) = delete;
+    result_type operator()(void);
+
+    // Method for seeding generator with entropy from operating system (throws std::runtime_error if unavailable)
+    void reseed(void);
+    static constexpr result_type max(void) noexcept;
+    static constexpr result_type min(void) noexcept;
+
+  private:
+    static constexpr std::size_t s_buffer_size = 128;
+    static constexpr uint32_t s_reseed_interval = 1u << 12;
+
+  private:
+    static std::atomic<uint32_t>& _fork_generation(void) noexcept;
+    void _refill(void);
+
+  private:
+    uint32_t m_key[8];
+    uint32_t m_buffer[2 * s_buffer_size];
+    std::size_t m_position;
+    uint32_t m_refills;
+    uint32_t m_generation;
+  };
+
+  // splitmix64 step, used for seed expansion
+  uint64_t splitmix64(uint64_t& p_state) noexcept;
+#pragma endregion
+
+#pragma region IMPLEMENTATION
+  inline uint32_t _chacha20_rotate_left(uint32_t p_value, int p_shift) noexcept
+  {
+    return p_value << p_shift | p_value >> (32 - p_shift);
+  }
+
+#ifdef FLIB_SSE2
+  inline __m128i _chacha20_rotate_left(__m128i p_value, int p_shift) noexcept
+  {
+    return _mm_or_si128(_mm_slli_epi32(p_value, p_shift), _mm_srli_epi32(p_value, 32 - p_shift));
+  }
+
+  inline void _chacha20_quarter_round(__m128i (&p_state)[16], int p_a, int p_b, int p_c, int p_d) noexcept
+  {
+    p_state[p_a] = _mm_add_epi32(p_state[p_a], p_state[p_b]);
+    // Rotation by 16 bits swaps halves of words
+    p_state[p_d] = _mm_xor_si128(p_state[p_d], p_state[p_a]);
+    p_state[p_d] = _mm_shufflelo_epi16(p_state[p_d], _MM_SHUFFLE(2, 3, 0, 1));
+    p_state[p_d] = _mm_shufflehi_epi16(p_state[p_d], _MM_SHUFFLE(2, 3, 0, 1));
+    p_state[p_c] = _mm_add_epi32(p_state[p_c], p_state[p_d]);
+    p_state[p_b] = _chacha20_rotate_left(_mm_xor_si128(p_state[p_b], p_state[p_c]), 12);
+    p_state[p_a] = _mm_add_epi32(p_state[p_a], p_state[p_b]);
+    p_state[p_d] = _chacha20_rotate_left(_mm_xor_si128(p_state[p_d], p_state[p_a]), 8);
+    p_state[p_c] = _mm_add_epi32(p_state[p_c], p_state[p_d]);
+    p_state[p_b] = _chacha20_rotate_left(_mm_xor_si128(p_state[p_b], p_state[p_c]), 7);
+  }
+#else
+  inline void _chacha20_quarter_round(uint32_t (&p_state)[16][4], int p_a, int p_b, int p_c, int p_d) noexcept
+  {
+    for (auto lane = 0; lane < 4; ++lane)
+    {
+      p_state[p_a][lane] += p_state[p_b][lane];
+      p_state[p_d][lane] = _chacha20_rotate_left(p_state[p_d][lane] ^ p_state[p_a][lane], 16);
+      p_state[p_c][lane] += p_state[p_d][lane];
+      p_state[p_b][lane] = _chacha20_rotate_left(p_state[p_b][lane] ^ p_state[p_c][lane], 12);
+      p_state[p_a][lane] += p_state[p_b][lane];
+      p_state[p_d][lane] = _chacha20_rotate_left(p_state[p_d][lane] ^ p_state[p_a][lane], 8);
+      p_state[p_c][lane] += p_state[p_d][lane];
+      p_state[p_b][lane] = _chacha20_rotate_left(p_state[p_b][lane] ^ p_state[p_c][lane], 7);
+    }
+  }
+#endif
+
+  // ChaCha20 block function computing 4 consecutive blocks (64 words of output), with blocks interleaved in lanes for
+  // vectorization
+  inline void _chacha20_blocks(const uint32_t (&p_key)[8], uint64_t p_stream, uint64_t p_counter,
+    uint32_t* p_output) noexcept
+  {
+#ifdef FLIB_SSE2
+    static constexpr uint32_t constants[] = { 0x61707865, 0x3320646e, 0x79622d32, 0x6b206574 };
+    __m128i input[16];
+    for (auto i = 0; i < 4; ++i)
+    {
+      input[i] = _mm_set1_epi32(static_cast<int>(constants[i]));
+    }
+    for (auto i = 0; i < 8; ++i)
+    {
+      input[4 + i] = _mm_set1_epi32(static_cast<int>(p_key[i]));
+    }
+    uint32_t counters[2][4];
+    for (auto lane = 0; lane < 4; ++lane)
+    {
+      auto counter = p_counter + static_cast<uint64_t>(lane);
+      counters[0][lane] = static_cast<uint32_t>(counter);
+      counters[1][lane] = static_cast<uint32_t>(counter >> 32);
+    }
+    input[12] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(counters[0]));
+    input[13] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(counters[1]));
+    input[14] = _mm_set1_epi32(static_cast<int>(static_cast<uint32_t>(p_stream)));
+    input[15] = _mm_set1_epi32(static_cast<int>(static_cast<uint32_t>(p_stream >> 32)));
+    __m128i state[16];
+    for (auto i = 0; i < 16; ++i)
+    {
+      state[i] = input[i];
+    }
+    for (auto round = 0; round < 10; ++round)
+    {
+      _chacha20_quarter_round(state, 0, 4, 8, 12);
+      _chacha20_quarter_round(state, 1, 5, 9, 13);
+      _chacha20_quarter_round(state, 2, 6, 10, 14);
+      _chacha20_quarter_round(state, 3, 7, 11, 15);
+      _chacha20_quarter_round(state, 0, 5, 10, 15);
+      _chacha20_quarter_round(state, 1, 6, 11, 12);
+      _chacha20_quarter_round(state, 2, 7, 8, 13);
+      _chacha20_quarter_round(state, 3, 4, 9, 14);
+    }
+    // Transposes each 4 words of 4 lanes into consecutive words of blocks
+    for (auto i = 0; i < 16; i += 4)
+    {
+      auto a = _mm_add_epi32(state[i], input[i]);
+      auto b = _mm_add_epi32(state[i + 1], input[i + 1]);
+      auto c = _mm_add_epi32(state[i + 2], input[i + 2]);
+      auto d = _mm_add_epi32(state[i + 3], input[i + 3]);
+      auto ab_low = _mm_unpacklo_epi32(a, b);
+      auto cd_low = _mm_unpacklo_epi32(c, d);
+      auto ab_high = _mm_unpackhi_epi32(a, b);
+      auto cd_high = _mm_unpackhi_epi32(c, d);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(p_output + i), _mm_unpacklo_epi64(ab_low, cd_low));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(p_output + 16 + i), _mm_unpackhi_epi64(ab_low, cd_low));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(p_output + 32 + i), _mm_unpacklo_epi64(ab_high, cd_high));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(p_output + 48 + i), _mm_unpackhi_epi64(ab_high, cd_high));
+    }
+#else
+    static constexpr uint32_t constants[] = { 0x61707865, 0x3320646e, 0x79622d32, 0x6b206574 };
+    uint32_t input[16][4];
+    for (auto lane = 0; lane < 4; ++lane)
+    {
+      for (auto i = 0; i < 4; ++i)
+      {
+        input[i][lane] = constants[i];
+      }
+      for (auto i = 0; i < 8; ++i)
+      {
+        input[4 + i][lane] = p_key[i];
+      }
+      auto counter = p_counter + static_cast<uint64_t>(lane);
+      input[12][lane] = static_cast<uint32_t>(counter);
+      input[13][lane] = static_cast<uint32_t>(counter >> 32);
+      input[14][lane] = static_cast<uint32_t>(p_stream);
+      input[15][lane] = static_cast<uint32_t>(p_stream >> 32);
+    }
+    uint32_t state[16][4];
+    std::memcpy(state, input, sizeof(state));
+    for (auto round = 0; round < 10; ++round)
+    {
+      _chacha20_quarter_round(state, 0, 4, 8, 12);
+      _chacha20_quarter_round(state, 1, 5, 9, 13);
+      _chacha20_quarter_round(state, 2, 6, 10, 14);
+      _chacha20_quarter_round(state, 3, 7, 11, 15);
+      _chacha20_quarter_round(state, 0, 5, 10, 15);
+      _chacha20_quarter_round(state, 1, 6, 11, 12);
+      _chacha20_quarter_round(state, 2, 7, 8, 13);
+      _chacha20_quarter_round(state, 3, 4, 9, 14);
+    }
+    for (auto lane = 0; lane < 4; ++lane)
+    {
+      for (auto i = 0; i < 16; ++i)
+      {
+        p_output[16 * lane + i] = state[i][lane] + input[i][lane];
+      }
+    }
+#endif
+  }
+
+  // Fills buffer with operating system entropy
+  inline void _secure_entropy(uint32_t* p_data, std::size_t p_count)
+  {
+#if defined(__linux__)
+    auto data = reinterpret_cast<char*>(p_data);
+    auto size = p_count * sizeof(uint32_t);
+    while (0 != size)
+    {
+      auto result = ::getrandom(data, size, 0);
+      if (result < 0)
+      {
+        if (EINTR == errno)
+        {
+          continue;
+        }
+        throw std::runtime_error("Entropy source failure (code: " + std::to_string(errno) + ")");
+      }
+      data += result;
+      size -= static_cast<std::size_t>(result);
+    }
+#else
+    std::random_device device;
+    for (; 0 != p_count; --p_count)
+    {
+      *p_data++ = static_cast<uint32_t>(device());
+    }
+#endif
+  }
+
+  inline uint64_t splitmix64(uint64_t& p_state) noexcept
+  {
+    auto result = (p_state += 0x9e3779b97f4a7c15ull);
+    result = (result ^ (result >> 30)) * 0xbf58476d1ce4e5b9ull;
+    result = (result ^ (result >> 27)) * 0x94d049bb133111ebull;
+    return result ^ (result >> 31);
+  }
+
+  inline xoshiro256ss::xoshiro256ss(void) noexcept
+  {
+    seed(s_default_seed);
+  }
+
+  inline xoshiro256ss::xoshiro256ss(uint64_t p_seed) noexcept
+  {
+    seed(p_seed);
+  }
+
+  inline xoshiro256ss::xoshiro256ss(std::seed_seq& p_sequence)
+  {
+    seed(p_sequence);
+  }
+
+  inline bool xoshiro256ss::operator==(const xoshiro256ss& p_other) const noexcept
+  {
+    return m_state[0] == p_other.m_state[0] && m_state[1] == p_other.m_state[1] && m_state[2] == p_other.m_state[2] &&
+      m_state[3] == p_other.m_state[3];
+  }
+
+  inline bool xoshiro256ss::operator!=(const xoshiro256ss& p_other) const noexcept
+  {
+    return !(*this == p_other);
+  }
+
+  inline xoshiro256ss::result_type xoshiro256ss::operator()(void) noexcept
+  {
+    auto result = _rotate_left(m_state[1] * 5, 7) * 9;
+    auto temp = m_state[1] << 17;
+    m_state[2] ^= m_state[0];
+    m_state[3] ^= m_state[1];
+    m_state[1] ^= m_state[2];
+    m_state[0] ^= m_state[3];
+    m_state[2] ^= temp;
+    m_state[3] = _rotate_left(m_state[3], 45);
+    return result;
+  }
+
+  inline void xoshiro256ss::discard(unsigned long long p_count) noexcept
+  {
+    for (; 0 != p_count; --p_count)
+    {
+      (*this)();
+    }
+  }
+
+  inline void xoshiro256ss::jump(void) noexcept
+  {
+    static constexpr uint64_t polynomial[] = { 0x180ec6d33cfd0abaull, 0xd5a61266f0c9392cull, 0xa9582618e03fc9aaull,
+      0x39abdc4529b1661cull };
+    _jump(polynomial);
+  }
+
+  inline void xoshiro256ss::long_jump(void) noexcept
+  {
+    static constexpr uint64_t polynomial[] = { 0x76e15d3efefdcbbfull, 0xc5004e441c522fb3ull, 0x77710069854ee241ull,
+      0x39109bb02acbe635ull };
+    _jump(polynomial);
+  }
+
+  inline void xoshiro256ss::seed(uint64_t p_seed) noexcept
+  {
+    for (auto& state : m_state)
+    {
+      state = splitmix64(p_seed);
+    }
+  }
+
+  inline void xoshiro256ss::seed(std::seed_seq& p_sequence)
+  {
+    uint32_t data[8];
+    p_sequence.generate(data, data + 8);
+    for (auto i = 0; i < 4; ++i)
+    {
+      m_state[i] = static_cast<uint64_t>(data[2 * i]) << 32 | data[2 * i + 1];
+    }
+    if (0 == (m_state[0] | m_state[1] | m_state[2] | m_state[3]))
+    {
+      seed(s_default_seed);
+    }
+  }
+
+  inline constexpr xoshiro256ss::result_type xoshiro256ss::max(void) noexcept
+  {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  inline constexpr xoshiro256ss::result_type xoshiro256ss::min(void) noexcept
+  {
+    return std::numeric_limits<result_type>::min();
+  }
+
+  inline void xoshiro256ss::_jump(const uint64_t (&p_polynomial)[4]) noexcept
+  {
+    uint64_t state[4]{};
+    for (auto word : p_polynomial)
+    {
+      for (auto bit = 0; bit < 64; ++bit)
+      {
+        if (0 != (word & 1ull << bit))
+        {
+          for (auto i = 0; i < 4; ++i)
+          {
+            state[i] ^= m_state[i];
+          }
+        }
+        (*this)();
+      }
+    }
+    for (auto i = 0; i < 4; ++i)
+    {
+      m_state[i] = state[i];
+    }
+  }
+
+  inline uint64_t xoshiro256ss::_rotate_left(uint64_t p_value, int p_shift) noexcept
+  {
+    return p_value << p_shift | p_value >> (64 - p_shift);
+  }
+
+  inline wyrand::wyrand(void) noexcept
+    : m_state(s_default_seed)
+  {
+  }
+
+  inline wyrand::wyrand(uint64_t p_seed) noexcept
+  {
+    seed(p_seed);
+  }
+
+  inline wyrand::wyrand(std::seed_seq& p_sequence)
+  {
+    seed(p_sequence);
+  }
+
+  inline bool wyrand::operator==(const wyrand& p_other) const noexcept
+  {
+    return m_state == p_other.m_state;
+  }
+
+  inline bool wyrand::operator!=(const wyrand& p_other) const noexcept
+  {
+    return !(*this == p_other);
+  }
+
+  inline wyrand::result_type wyrand::operator()(void) noexcept
+  {
+    m_state += 0xa0761d6478bd642full;
+    auto lhs = m_state;
+    auto rhs = m_state ^ 0xe7037ed1a0b428dbull;
+    // 64x64 -> 128-bit multiplication, folded by xor of halves
+#if defined(__SIZEOF_INT128__)
+    __extension__ typedef unsigned __int128 uint128_t;
+    auto product = static_cast<uint128_t>(lhs) * rhs;
+    return static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64);
+#elif defined(_MSC_VER) & defined(_M_X64)
+    uint64_t high = 0;
+    auto low = _umul128(lhs, rhs, &high);
+    return low ^ high;
+#else
+    auto lhs_high = lhs >> 32;
+    auto lhs_low = lhs & 0xffffffffull;
+    auto rhs_high = rhs >> 32;
+    auto rhs_low = rhs & 0xffffffffull;
+    auto low_low = lhs_low * rhs_low;
+    auto high_low = lhs_high * rhs_low;
+    auto low_high = lhs_low * rhs_high;
+    auto middle = (low_low >> 32) + (high_low & 0xffffffffull) + (low_high & 0xffffffffull);
+    auto high = lhs_high * rhs_high + (high_low >> 32) + (low_high >> 32) + (middle >> 32);
+    auto low = middle << 32 | (low_low & 0xffffffffull);
+    return low ^ high;
+#endif
+  }
+
+  inline void wyrand::discard(unsigned long long p_count) noexcept
+  {
+    m_state += 0xa0761d6478bd642full * static_cast<uint64_t>(p_count);
+  }
+
+  inline void wyrand::seed(uint64_t p_seed) noexcept
+  {
+    m_state = splitmix64(p_seed);
+  }
+
+  inline void wyrand::seed(std::seed_seq& p_sequence)
+  {
+    uint32_t data[2];
+    p_sequence.generate(data, data + 2);
+    m_state = static_cast<uint64_t>(data[0]) << 32 | data[1];
+  }
+
+  inline constexpr wyrand::result_type wyrand::max(void) noexcept
+  {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  inline constexpr wyrand::result_type wyrand::min(void) noexcept
+  {
+    return std::numeric_limits<result_type>::min();
+  }
+
+  inline chacha20::chacha20(void) noexcept
+  {
+    seed(s_default_seed);
+  }
+
+  inline chacha20::chacha20(uint64_t p_seed) noexcept
+  {
+    seed(p_seed);
+  }
+
+  inline chacha20::chacha20(std::seed_seq& p_sequence)
+  {
+    seed(p_sequence);
+  }
+
+  inline chacha20::chacha20(const uint32_t (&p_key)[8], uint64_t p_stream, uint64_t p_counter) noexcept
+  {
+    seed(p_key, p_stream, p_counter);
+  }
+
+  // Generators are equal when positioned at same keystream word
+  inline bool chacha20::operator==(const chacha20& p_other) const noexcept
+  {
+    return 0 == std::memcmp(m_key, p_other.m_key, sizeof(m_key)) && m_stream == p_other.m_stream &&
+      m_counter * 8 + m_position == p_other.m_counter * 8 + p_other.m_position;
+  }
+
+  inline bool chacha20::operator!=(const chacha20& p_other) const noexcept
+  {
+    return !(*this == p_other);
+  }
+
+  inline chacha20::result_type chacha20::operator()(void) noexcept
+  {
+    if (s_buffer_size == m_position)
+    {
+      _refill();
+    }
+    auto result = static_cast<uint64_t>(m_buffer[2 * m_position + 1]) << 32 | m_buffer[2 * m_position];
+    ++m_position;
+    return result;
+  }
+
+  inline void chacha20::discard(unsigned long long p_count) noexcept
+  {
+    // Buffer holds s_buffer_size / 8 blocks preceding counter
+    auto position = m_position + static_cast<uint64_t>(p_count);
+    if (position < s_buffer_size)
+    {
+      m_position = static_cast<std::size_t>(position);
+      return;
+    }
+    m_counter += (position / s_buffer_size - 1) * (s_buffer_size / 8);
+    _refill();
+    m_position = static_cast<std::size_t>(position % s_buffer_size);
+  }
+
+  inline void chacha20::seed(uint64_t p_seed) noexcept
+  {
+    uint32_t key[8];
+    for (auto i = 0; i < 8; i += 2)
+    {
+      auto value = splitmix64(p_seed);
+      key[i] = static_cast<uint32_t>(value);
+      key[i + 1] = static_cast<uint32_t>(value >> 32);
+    }
+    seed(key, 0);
+  }
+
+  inline void chacha20::seed(std::seed_seq& p_sequence)
+  {
+    uint32_t data[10];
+    p_sequence.generate(data, data + 10);
+    uint32_t key[8];
+    std::memcpy(key, data, sizeof(key));
+    seed(key, static_cast<uint64_t>(data[9]) << 32 | data[8]);
+  }
+
+  inline void chacha20::seed(const uint32_t (&p_key)[8], uint64_t p_stream, uint64_t p_counter) noexcept
+  {
+    std::memcpy(m_key, p_key, sizeof(m_key));
+    m_stream = p_stream;
+    m_counter = p_counter;
+    _refill();
+  }
+
+  inline constexpr chacha20::result_type chacha20::max(void) noexcept
+  {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  inline constexpr chacha20::result_type chacha20::min(void) noexcept
+  {
+    return std::numeric_limits<result_type>::min();
+  }
+
+  inline void chacha20::_refill(void) noexcept
+  {
+    for (std::size_t i = 0; i < s_buffer_size / 8; i += 4)
+    {
+      _chacha20_blocks(m_key, m_stream, m_counter + i, m_buffer + 16 * i);
+    }
+    m_counter += s_buffer_size / 8;
+    m_position = 0;
+  }
+
+  inline secure_generator::secure_generator(void)
+  {
+#if defined(__unix__) | defined(__APPLE__)
+    // Child process reseeds after fork, as it would otherwise repeat parent output
+    static const auto registered = ::pthread_atfork(nullptr, nullptr, []()
+      {
+        _fork_generation().fetch_add(1, std::memory_order_relaxed);
+      });
+    (void)registered;
+#endif
+    reseed();
+  }
+
+  inline secure_generator::~secure_generator(void) noexcept
+  {
+    // Erasure through volatile function pointer is not optimized out
+    static void* (* const volatile erase)(void*, int, std::size_t) = std::memset;
+    erase(m_key, 0, sizeof(m_key));
+    erase(m_buffer, 0, sizeof(m_buffer));
+  }
+
+  inline secure_generator::result_type secure_generator::operator()(void)
+  {
+    if (m_generation != _fork_generation().load(std::memory_order_relaxed))
+    {
+      reseed();
+    }
+    if (s_buffer_size == m_position)
+    {
+      _refill();
+    }
+    auto result = static_cast<uint64_t>(m_buffer[2 * m_position + 1]) << 32 | m_buffer[2 * m_position];
+    // Served output is erased from buffer
+    m_buffer[2 * m_position] = 0;
+    m_buffer[2 * m_position + 1] = 0;
+    ++m_position;
+    return result;
+  }
+
+  inline void secure_generator::reseed(void)
+  {
+    m_generation = _fork_generation().load(std::memory_order_relaxed);
+    _secure_entropy(m_key, 8);
+    m_refills = 0;
+    _refill();
+  }
+
+  inline constexpr secure_generator::result_type secure_generator::max(void) noexcept
+  {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  inline constexpr secure_generator::result_type secure_generator::min(void) noexcept
+  {
+    return std::numeric_limits<result_type>::min();
+  }
+
+  inline std::atomic<uint32_t>& secure_generator::_fork_generation(void) noexcept
+  {
+    static std::atomic<uint32_t> generation(0);
+    return generation;
+  }
+
+  inline void secure_generator::_refill(void)
+  {
+    if (s_reseed_interval == ++m_refills)
+    {
+      reseed();
+      return;
+    }
+    for (std::size_t i = 0; i < s_buffer_size / 8; i += 4)
+    {
+      _chacha20_blocks(m_key, 0, i, m_buffer + 16 * i);
+    }
+    std::memcpy(m_key, m_buffer, sizeof(m_key));
+    std::memset(m_buffer, 0, sizeof(m_key));
+    m_position = sizeof(m_key) / 8;
+  }
+#pragma endregion
+}
\ No newline at end of file
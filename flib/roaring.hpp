@@ -0,0 +1,988 @@
+// Copyright © 2024 Luka Arnecic.
+// See the LICENSE file at the top-level directory of this distribution.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <flib/bit.hpp>
+
+#if !defined(FLIB_NO_SSE2) & (defined(__SSE2__) | defined(_M_X64))
+#  define FLIB_SSE2
+#  include <emmintrin.h>
+#endif
+
+namespace flib
+{
+#pragma region API
+  // Optional macros:
+  //  - FLIB_NO_SSE2 ... disables use of SSE2 instructions in set operations of roaring_bitmap
+  //
+  // SSE2 instructions are used when enabled for compilation (default for x86-64), otherwise bitmap containers are
+  // combined and array containers are intersected with portable scalar loops
+
+  // Compressed bitmap of 32-bit unsigned integers (roaring bitmap)
+  //
+  // Values are partitioned by their upper 16 bits into containers, which store lower 16 bits either as:
+  //   - array .... sorted values, used for sparse containers (up to 4096 values)
+  //   - bitmap ... 65536-bit bitmap, used for dense containers
+  //   - run ...... sorted value ranges, used only after run_optimize() where more compact than other representations
+  class roaring_bitmap
+  {
+  public:
+    roaring_bitmap(void) = default;
+    roaring_bitmap(std::initializer_list<uint32_t> p_values);
+    roaring_bitmap(const uint32_t* p_data_start, const uint32_t* p_data_end);
+    roaring_bitmap& operator&=(const roaring_bitmap& p_other);
+    roaring_bitmap& operator|=(const roaring_bitmap& p_other);
+    roaring_bitmap& operator-=(const roaring_bitmap& p_other);
+    bool operator==(const roaring_bitmap& p_other) const;
+    bool operator!=(const roaring_bitmap& p_other) const;
+    void add(uint32_t p_value);
+    void add(const uint32_t* p_data_start, const uint32_t* p_data_end);
+    uint64_t cardinality(void) const noexcept;
+    void clear(void) noexcept;
+    bool contains(uint32_t p_value) const noexcept;
+    bool empty(void) const noexcept;
+    template<class Function>
+    void for_each(Function p_function) const;
+    void remove(uint32_t p_value);
+    void run_optimize(void);
+    std::vector<uint8_t> serialize(void) const;
+    std::size_t serialized_size(void) const noexcept;
+    std::vector<uint32_t> values(void) const;
+
+    // Method for reconstructing bitmap from serialized form
+    //
+    // Parameters:
+    //   p_data - Pointer to serialized bitmap
+    //   p_size - Serialized bitmap size in bytes
+    //
+    // Returns:
+    //   deserialized bitmap
+    static roaring_bitmap deserialize(const uint8_t* p_data, std::size_t p_size);
+
+  private:
+    friend class roaring_view;
+
+    enum class _type_t
+      : uint8_t
+    {
+      array = 1,
+      bitmap = 2,
+      run = 3
+    };
+
+    struct _container;
+
+    using _words_t = std::vector<uint64_t>;
+
+    static constexpr uint32_t s_array_limit = 4096;
+    static constexpr std::size_t s_bitmap_words = 1024;
+    static constexpr uint32_t s_serial_magic = 0x31425246ul;
+    static constexpr std::size_t s_serial_header_size = 8;
+    static constexpr std::size_t s_serial_descriptor_size = 16;
+
+  private:
+    static _container _and(const _container& p_lhs, const _container& p_rhs);
+    static _container _andnot(const _container& p_lhs, const _container& p_rhs);
+    static bool _contains(const _container& p_container, uint16_t p_value) noexcept;
+    template<class Function>
+    static void _for_each(const _container& p_container, Function& p_function);
+    static _container _from_words(uint16_t p_key, const _words_t& p_words);
+    static void _normalize(_container& p_container);
+    static _container _or(const _container& p_lhs, const _container& p_rhs);
+    static std::size_t _payload_size(const _container& p_container) noexcept;
+    static _words_t _to_words(const _container& p_container);
+    std::vector<_container>::iterator _find(uint16_t p_key);
+    std::vector<_container>::const_iterator _find(uint16_t p_key) const;
+
+  private:
+    std::vector<_container> m_containers;
+  };
+
+  roaring_bitmap operator&(roaring_bitmap p_lhs, const roaring_bitmap& p_rhs);
+
+  roaring_bitmap operator|(roaring_bitmap p_lhs, const roaring_bitmap& p_rhs);
+
+  roaring_bitmap operator-(roaring_bitmap p_lhs, const roaring_bitmap& p_rhs);
+
+  // Read-only view of serialized roaring bitmap
+  //
+  // Queries are answered directly from serialized data (e.g. memory-mapped file), without deserialization. Referenced
+  // data must outlive the view.
+  class roaring_view
+  {
+  public:
+    roaring_view(const uint8_t* p_data, std::size_t p_size);
+    uint64_t cardinality(void) const noexcept;
+    bool contains(uint32_t p_value) const noexcept;
+    bool empty(void) const noexcept;
+
+  private:
+    friend class roaring_bitmap;
+
+    const uint8_t* _descriptor(std::size_t p_index) const noexcept;
+
+  private:
+    const uint8_t* m_data;
+    std::size_t m_count;
+  };
+#pragma endregion
+
+#pragma region IMPLEMENTATION
+  struct roaring_bitmap::_container
+  {
+    uint16_t key{ 0 };
+    _type_t type{ _type_t::array };
+    uint32_t cardinality{ 0 };
+    std::vector<uint16_t> values; // array values or run (start, length - 1) pairs
+    _words_t words;
+  };
+
+  inline uint16_t _roaring_load16(const uint8_t* p_data) noexcept
+  {
+    return static_cast<uint16_t>(p_data[0] | p_data[1] << 8);
+  }
+
+  inline uint32_t _roaring_load32(const uint8_t* p_data) noexcept
+  {
+    return static_cast<uint32_t>(_roaring_load16(p_data)) | static_cast<uint32_t>(_roaring_load16(p_data + 2)) << 16;
+  }
+
+  inline uint64_t _roaring_load64(const uint8_t* p_data) noexcept
+  {
+    return static_cast<uint64_t>(_roaring_load32(p_data)) | static_cast<uint64_t>(_roaring_load32(p_data + 4)) << 32;
+  }
+
+  inline uint8_t* _roaring_store16(uint8_t* p_data, uint16_t p_value) noexcept
+  {
+    p_data[0] = static_cast<uint8_t>(p_value);
+    p_data[1] = static_cast<uint8_t>(p_value >> 8);
+    return p_data + 2;
+  }
+
+  inline uint8_t* _roaring_store32(uint8_t* p_data, uint32_t p_value) noexcept
+  {
+    return _roaring_store16(_roaring_store16(p_data, static_cast<uint16_t>(p_value)), static_cast<uint16_t>(p_value >> 16));
+  }
+
+  inline uint8_t* _roaring_store64(uint8_t* p_data, uint64_t p_value) noexcept
+  {
+    return _roaring_store32(_roaring_store32(p_data, static_cast<uint32_t>(p_value)), static_cast<uint32_t>(p_value >> 32));
+  }
+
+  inline void _roaring_and_words(uint64_t* p_words, const uint64_t* p_other, std::size_t p_size) noexcept
+  {
+    std::size_t i = 0;
+#ifdef FLIB_SSE2
+    for (; i + 2 <= p_size; i += 2)
+    {
+      auto words = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p_words + i));
+      auto other = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p_other + i));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(p_words + i), _mm_and_si128(words, other));
+    }
+#endif
+    for (; i < p_size; ++i)
+    {
+      p_words[i] &= p_other[i];
+    }
+  }
+
+  inline void _roaring_andnot_words(uint64_t* p_words, const uint64_t* p_other, std::size_t p_size) noexcept
+  {
+    std::size_t i = 0;
+#ifdef FLIB_SSE2
+    for (; i + 2 <= p_size; i += 2)
+    {
+      auto words = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p_words + i));
+      auto other = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p_other + i));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(p_words + i), _mm_andnot_si128(other, words));
+    }
+#endif
+    for (; i < p_size; ++i)
+    {
+      p_words[i] &= ~p_other[i];
+    }
+  }
+
+  inline void _roaring_or_words(uint64_t* p_words, const uint64_t* p_other, std::size_t p_size) noexcept
+  {
+    std::size_t i = 0;
+#ifdef FLIB_SSE2
+    for (; i + 2 <= p_size; i += 2)
+    {
+      auto words = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p_words + i));
+      auto other = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p_other + i));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(p_words + i), _mm_or_si128(words, other));
+    }
+#endif
+    for (; i < p_size; ++i)
+    {
+      p_words[i] |= p_other[i];
+    }
+  }
+
+  // Intersects sorted arrays of unique values, writing result into output of at least smaller array size
+  //
+  // Returns number of written values
+  inline std::size_t _roaring_intersect(const uint16_t* p_lhs, std::size_t p_lhs_size, const uint16_t* p_rhs,
+    std::size_t p_rhs_size, uint16_t* p_output) noexcept
+  {
+    auto output = p_output;
+    std::size_t i = 0;
+    std::size_t j = 0;
+#ifdef FLIB_SSE2
+    // Blocks of 8 values are compared all-to-all (against all rotations of other block), after which block with smaller
+    // maximum is advanced, so that every pair of equal values meets in exactly one comparison
+    while (i + 8 <= p_lhs_size && j + 8 <= p_rhs_size)
+    {
+      auto lhs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p_lhs + i));
+      auto rhs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p_rhs + j));
+      auto rotated = _mm_or_si128(_mm_srli_si128(rhs, 2), _mm_slli_si128(rhs, 14));
+      auto mask = _mm_or_si128(_mm_cmpeq_epi16(lhs, rhs), _mm_cmpeq_epi16(lhs, rotated));
+      mask = _mm_or_si128(mask, _mm_cmpeq_epi16(lhs, _mm_shuffle_epi32(rhs, _MM_SHUFFLE(0, 3, 2, 1))));
+      mask = _mm_or_si128(mask, _mm_cmpeq_epi16(lhs, _mm_shuffle_epi32(rotated, _MM_SHUFFLE(0, 3, 2, 1))));
+      mask = _mm_or_si128(mask, _mm_cmpeq_epi16(lhs, _mm_shuffle_epi32(rhs, _MM_SHUFFLE(1, 0, 3, 2))));
+      mask = _mm_or_si128(mask, _mm_cmpeq_epi16(lhs, _mm_shuffle_epi32(rotated, _MM_SHUFFLE(1, 0, 3, 2))));
+      mask = _mm_or_si128(mask, _mm_cmpeq_epi16(lhs, _mm_shuffle_epi32(rhs, _MM_SHUFFLE(2, 1, 0, 3))));
+      mask = _mm_or_si128(mask, _mm_cmpeq_epi16(lhs, _mm_shuffle_epi32(rotated, _MM_SHUFFLE(2, 1, 0, 3))));
+      for (auto bits = static_cast<uint32_t>(_mm_movemask_epi8(mask)) & 0x5555u; 0 != bits; bits &= bits - 1)
+      {
+        *output++ = p_lhs[i + countr_zero(bits) / 2];
+      }
+      auto lhs_max = p_lhs[i + 7];
+      auto rhs_max = p_rhs[j + 7];
+      i += lhs_max <= rhs_max ? 8 : 0;
+      j += rhs_max <= lhs_max ? 8 : 0;
+    }
+#endif
+    while (i < p_lhs_size && j < p_rhs_size)
+    {
+      if (p_lhs[i] < p_rhs[j])
+      {
+        ++i;
+      }
+      else if (p_rhs[j] < p_lhs[i])
+      {
+        ++j;
+      }
+      else
+      {
+        *output++ = p_lhs[i++];
+        ++j;
+      }
+    }
+    return static_cast<std::size_t>(output - p_output);
+  }
+
+  template<class Getter>
+  inline bool _roaring_array_contains(Getter p_get, std::size_t p_size, uint16_t p_value) noexcept
+  {
+    std::size_t low = 0;
+    while (low < p_size)
+    {
+      auto middle = low + (p_size - low) / 2;
+      auto value = p_get(middle);
+      if (value == p_value)
+      {
+        return true;
+      }
+      if (value < p_value)
+      {
+        low = middle + 1;
+      }
+      else
+      {
+        p_size = middle;
+      }
+    }
+    return false;
+  }
+
+  template<class Getter>
+  inline bool _roaring_run_contains(Getter p_get, std::size_t p_runs, uint16_t p_value) noexcept
+  {
+    std::size_t low = 0;
+    while (low < p_runs)
+    {
+      auto middle = low + (p_runs - low) / 2;
+      if (p_get(2 * middle) <= p_value)
+      {
+        low = middle + 1;
+      }
+      else
+      {
+        p_runs = middle;
+      }
+    }
+    return 0 != low && p_value - p_get(2 * (low - 1)) <= p_get(2 * (low - 1) + 1);
+  }
+
+  inline roaring_bitmap::roaring_bitmap(std::initializer_list<uint32_t> p_values)
+  {
+    add(p_values.begin(), p_values.end());
+  }
+
+  inline roaring_bitmap::roaring_bitmap(const uint32_t* p_data_start, const uint32_t* p_data_end)
+  {
+    add(p_data_start, p_data_end);
+  }
+
+  inline roaring_bitmap& roaring_bitmap::operator&=(const roaring_bitmap& p_other)
+  {
+    std::vector<_container> result;
+    auto lhs = m_containers.cbegin();
+    auto rhs = p_other.m_containers.cbegin();
+    while (lhs != m_containers.cend() && rhs != p_other.m_containers.cend())
+    {
+      if (lhs->key < rhs->key)
+      {
+        ++lhs;
+      }
+      else if (rhs->key < lhs->key)
+      {
+        ++rhs;
+      }
+      else
+      {
+        auto container = _and(*lhs++, *rhs++);
+        if (0 != container.cardinality)
+        {
+          result.push_back(std::move(container));
+        }
+      }
+    }
+    m_containers = std::move(result);
+    return *this;
+  }
+
+  inline roaring_bitmap& roaring_bitmap::operator|=(const roaring_bitmap& p_other)
+  {
+    std::vector<_container> result;
+    result.reserve(std::max(m_containers.size(), p_other.m_containers.size()));
+    auto lhs = m_containers.begin();
+    auto rhs = p_other.m_containers.cbegin();
+    while (lhs != m_containers.end() || rhs != p_other.m_containers.cend())
+    {
+      if (rhs == p_other.m_containers.cend() || (lhs != m_containers.end() && lhs->key < rhs->key))
+      {
+        result.push_back(std::move(*lhs++));
+      }
+      else if (lhs == m_containers.end() || rhs->key < lhs->key)
+      {
+        result.push_back(*rhs++);
+      }
+      else
+      {
+        result.push_back(_or(*lhs++, *rhs++));
+      }
+    }
+    m_containers = std::move(result);
+    return *this;
+  }
+
+  inline roaring_bitmap& roaring_bitmap::operator-=(const roaring_bitmap& p_other)
+  {
+    std::vector<_container> result;
+    result.reserve(m_containers.size());
+    auto rhs = p_other.m_containers.cbegin();
+    for (auto& lhs : m_containers)
+    {
+      while (rhs != p_other.m_containers.cend() && rhs->key < lhs.key)
+      {
+        ++rhs;
+      }
+      if (rhs == p_other.m_containers.cend() || rhs->key != lhs.key)
+      {
+        result.push_back(std::move(lhs));
+        continue;
+      }
+      auto container = _andnot(lhs, *rhs);
+      if (0 != container.cardinality)
+      {
+        result.push_back(std::move(container));
+      }
+    }
+    m_containers = std::move(result);
+    return *this;
+  }
+
+  inline bool roaring_bitmap::operator==(const roaring_bitmap& p_other) const
+  {
+    if (m_containers.size() != p_other.m_containers.size())
+    {
+      return false;
+    }
+    for (std::size_t i = 0; i < m_containers.size(); ++i)
+    {
+      const auto& lhs = m_containers[i];
+      const auto& rhs = p_other.m_containers[i];
+      if (lhs.key != rhs.key || lhs.cardinality != rhs.cardinality)
+      {
+        return false;
+      }
+      if (lhs.type == rhs.type ? lhs.values != rhs.values || lhs.words != rhs.words : _to_words(lhs) != _to_words(rhs))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  inline bool roaring_bitmap::operator!=(const roaring_bitmap& p_other) const
+  {
+    return !(*this == p_other);
+  }
+
+  inline void roaring_bitmap::add(uint32_t p_value)
+  {
+    auto key = static_cast<uint16_t>(p_value >> 16);
+    auto value = static_cast<uint16_t>(p_value);
+    auto it = _find(key);
+    if (m_containers.end() == it || key != it->key)
+    {
+      it = m_containers.insert(it, _container{});
+      it->key = key;
+    }
+    if (_type_t::run == it->type)
+    {
+      if (_contains(*it, value))
+      {
+        return;
+      }
+      _normalize(*it);
+    }
+    if (_type_t::bitmap == it->type)
+    {
+      auto& word = it->words[value >> 6];
+      auto mask = 1ull << (value & 63u);
+      if (0 == (word & mask))
+      {
+        word |= mask;
+        ++it->cardinality;
+      }
+      return;
+    }
+    auto position = std::lower_bound(it->values.begin(), it->values.end(), value);
+    if (it->values.end() != position && value == *position)
+    {
+      return;
+    }
+    it->values.insert(position, value);
+    if (++it->cardinality > s_array_limit)
+    {
+      *it = _from_words(key, _to_words(*it));
+    }
+  }
+
+  inline void roaring_bitmap::add(const uint32_t* p_data_start, const uint32_t* p_data_end)
+  {
+    for (; p_data_start != p_data_end; ++p_data_start)
+    {
+      add(*p_data_start);
+    }
+  }
+
+  inline uint64_t roaring_bitmap::cardinality(void) const noexcept
+  {
+    uint64_t result = 0;
+    for (const auto& container : m_containers)
+    {
+      result += container.cardinality;
+    }
+    return result;
+  }
+
+  inline void roaring_bitmap::clear(void) noexcept
+  {
+    m_containers.clear();
+  }
+
+  inline bool roaring_bitmap::contains(uint32_t p_value) const noexcept
+  {
+    auto key = static_cast<uint16_t>(p_value >> 16);
+    auto it = _find(key);
+    return m_containers.cend() != it && key == it->key && _contains(*it, static_cast<uint16_t>(p_value));
+  }
+
+  inline roaring_bitmap roaring_bitmap::deserialize(const uint8_t* p_data, std::size_t p_size)
+  {
+    roaring_view view(p_data, p_size);
+    roaring_bitmap result;
+    result.m_containers.resize(view.m_count);
+    for (std::size_t i = 0; i < view.m_count; ++i)
+    {
+      auto descriptor = view._descriptor(i);
+      auto& container = result.m_containers[i];
+      container.key = _roaring_load16(descriptor);
+      container.type = static_cast<_type_t>(descriptor[2]);
+      container.cardinality = _roaring_load32(descriptor + 8);
+      auto elements = _roaring_load32(descriptor + 4);
+      auto payload = p_data + _roaring_load32(descriptor + 12);
+      if (_type_t::bitmap == container.type)
+      {
+        container.words.resize(elements);
+        for (auto& word : container.words)
+        {
+          word = _roaring_load64(payload);
+          payload += 8;
+        }
+        continue;
+      }
+      container.values.resize(_type_t::run == container.type ? 2 * elements : elements);
+      for (auto& value : container.values)
+      {
+        value = _roaring_load16(payload);
+        payload += 2;
+      }
+    }
+    return result;
+  }
+
+  inline bool roaring_bitmap::empty(void) const noexcept
+  {
+    return m_containers.empty();
+  }
+
+  template<class Function>
+  inline void roaring_bitmap::for_each(Function p_function) const
+  {
+    for (const auto& container : m_containers)
+    {
+      auto high = static_cast<uint32_t>(container.key) << 16;
+      auto function = [&](uint16_t p_value)
+        {
+          p_function(high | p_value);
+        };
+      _for_each(container, function);
+    }
+  }
+
+  inline void roaring_bitmap::remove(uint32_t p_value)
+  {
+    auto key = static_cast<uint16_t>(p_value >> 16);
+    auto value = static_cast<uint16_t>(p_value);
+    auto it = _find(key);
+    if (m_containers.end() == it || key != it->key || !_contains(*it, value))
+    {
+      return;
+    }
+    _normalize(*it);
+    if (_type_t::bitmap == it->type)
+    {
+      it->words[value >> 6] &= ~(1ull << (value & 63u));
+      if (--it->cardinality <= s_array_limit)
+      {
+        *it = _from_words(key, it->words);
+      }
+    }
+    else
+    {
+      it->values.erase(std::lower_bound(it->values.begin(), it->values.end(), value));
+      --it->cardinality;
+    }
+    if (0 == it->cardinality)
+    {
+      m_containers.erase(it);
+    }
+  }
+
+  inline void roaring_bitmap::run_optimize(void)
+  {
+    for (auto& container : m_containers)
+    {
+      std::vector<uint16_t> runs;
+      auto function = [&runs](uint16_t p_value)
+        {
+          if (!runs.empty() && static_cast<uint32_t>(runs[runs.size() - 2]) + runs.back() + 1 == p_value)
+          {
+            ++runs.back();
+          }
+          else
+          {
+            runs.push_back(p_value);
+            runs.push_back(0);
+          }
+        };
+      _for_each(container, function);
+      auto run_size = runs.size() * sizeof(uint16_t);
+      if (run_size < std::min<std::size_t>(container.cardinality * sizeof(uint16_t), s_bitmap_words * sizeof(uint64_t)))
+      {
+        container.type = _type_t::run;
+        container.values = std::move(runs);
+        container.words = {};
+      }
+      else
+      {
+        _normalize(container);
+      }
+    }
+  }
+
+  inline std::vector<uint8_t> roaring_bitmap::serialize(void) const
+  {
+    std::vector<uint8_t> result(serialized_size());
+    auto header = _roaring_store32(_roaring_store32(result.data(), s_serial_magic), static_cast<uint32_t>(m_containers.size()));
+    auto offset = s_serial_header_size + m_containers.size() * s_serial_descriptor_size;
+    for (const auto& container : m_containers)
+    {
+      offset = (offset + 7) & ~std::size_t{ 7 };
+      auto elements = _type_t::bitmap == container.type ? container.words.size() :
+        _type_t::run == container.type ? container.values.size() / 2 : container.values.size();
+      header = _roaring_store16(header, container.key);
+      *header++ = static_cast<uint8_t>(container.type);
+      *header++ = 0;
+      header = _roaring_store32(header, static_cast<uint32_t>(elements));
+      header = _roaring_store32(header, container.cardinality);
+      header = _roaring_store32(header, static_cast<uint32_t>(offset));
+      auto payload = result.data() + offset;
+      for (auto word : container.words)
+      {
+        payload = _roaring_store64(payload, word);
+      }
+      for (auto value : container.values)
+      {
+        payload = _roaring_store16(payload, value);
+      }
+      offset += _payload_size(container);
+    }
+    return result;
+  }
+
+  inline std::size_t roaring_bitmap::serialized_size(void) const noexcept
+  {
+    auto result = s_serial_header_size + m_containers.size() * s_serial_descriptor_size;
+    for (const auto& container : m_containers)
+    {
+      result = ((result + 7) & ~std::size_t{ 7 }) + _payload_size(container);
+    }
+    return result;
+  }
+
+  inline std::vector<uint32_t> roaring_bitmap::values(void) const
+  {
+    std::vector<uint32_t> result;
+    result.reserve(static_cast<std::size_t>(cardinality()));
+    for_each([&result](uint32_t p_value)
+      {
+        result.push_back(p_value);
+      });
+    return result;
+  }
+
+  inline roaring_bitmap::_container roaring_bitmap::_and(const _container& p_lhs, const _container& p_rhs)
+  {
+    if (_type_t::array == p_lhs.type || _type_t::array == p_rhs.type)
+    {
+      const auto& array = _type_t::array == p_lhs.type ? p_lhs : p_rhs;
+      const auto& other = _type_t::array == p_lhs.type ? p_rhs : p_lhs;
+      _container result;
+      result.key = p_lhs.key;
+      if (_type_t::array == other.type)
+      {
+        result.values.resize(std::min(array.values.size(), other.values.size()));
+        result.values.resize(_roaring_intersect(array.values.data(), array.values.size(), other.values.data(),
+          other.values.size(), result.values.data()));
+      }
+      else
+      {
+        std::copy_if(array.values.cbegin(), array.values.cend(), std::back_inserter(result.values),
+          [&other](uint16_t p_value)
+          {
+            return _contains(other, p_value);
+          });
+      }
+      result.cardinality = static_cast<uint32_t>(result.values.size());
+      return result;
+    }
+    auto words = _to_words(p_lhs);
+    _words_t temp;
+    const auto& other = _type_t::bitmap == p_rhs.type ? p_rhs.words : (temp = _to_words(p_rhs));
+    _roaring_and_words(words.data(), other.data(), s_bitmap_words);
+    return _from_words(p_lhs.key, words);
+  }
+
+  inline roaring_bitmap::_container roaring_bitmap::_andnot(const _container& p_lhs, const _container& p_rhs)
+  {
+    if (_type_t::array == p_lhs.type)
+    {
+      _container result;
+      result.key = p_lhs.key;
+      if (_type_t::array == p_rhs.type)
+      {
+        std::set_difference(p_lhs.values.cbegin(), p_lhs.values.cend(), p_rhs.values.cbegin(), p_rhs.values.cend(),
+          std::back_inserter(result.values));
+      }
+      else
+      {
+        std::copy_if(p_lhs.values.cbegin(), p_lhs.values.cend(), std::back_inserter(result.values),
+          [&p_rhs](uint16_t p_value)
+          {
+            return !_contains(p_rhs, p_value);
+          });
+      }
+      result.cardinality = static_cast<uint32_t>(result.values.size());
+      return result;
+    }
+    auto words = _to_words(p_lhs);
+    _words_t temp;
+    const auto& other = _type_t::bitmap == p_rhs.type ? p_rhs.words : (temp = _to_words(p_rhs));
+    _roaring_andnot_words(words.data(), other.data(), s_bitmap_words);
+    return _from_words(p_lhs.key, words);
+  }
+
+  inline bool roaring_bitmap::_contains(const _container& p_container, uint16_t p_value) noexcept
+  {
+    switch (p_container.type)
+    {
+    case _type_t::bitmap:
+      return 0 != (p_container.words[p_value >> 6] >> (p_value & 63u) & 1u);
+    case _type_t::run:
+      return _roaring_run_contains([&p_container](std::size_t p_index)
+        {
+          return p_container.values[p_index];
+        }, p_container.values.size() / 2, p_value);
+    default:
+      return std::binary_search(p_container.values.cbegin(), p_container.values.cend(), p_value);
+    }
+  }
+
+  template<class Function>
+  inline void roaring_bitmap::_for_each(const _container& p_container, Function& p_function)
+  {
+    switch (p_container.type)
+    {
+    case _type_t::bitmap:
+      for (std::size_t i = 0; i < p_container.words.size(); ++i)
+      {
+        for (auto word = p_container.words[i]; 0 != word; word &= word - 1)
+        {
+          p_function(static_cast<uint16_t>(i * 64 + countr_zero(word)));
+        }
+      }
+      break;
+    case _type_t::run:
+      for (std::size_t i = 0; i < p_container.values.size(); i += 2)
+      {
+        for (uint32_t value = p_container.values[i], end = value + p_container.values[i + 1]; value <= end; ++value)
+        {
+          p_function(static_cast<uint16_t>(value));
+        }
+      }
+      break;
+    default:
+      for (auto value : p_container.values)
+      {
+        p_function(value);
+      }
+      break;
+    }
+  }
+
+  inline roaring_bitmap::_container roaring_bitmap::_from_words(uint16_t p_key, const _words_t& p_words)
+  {
+    _container result;
+    result.key = p_key;
+    for (auto word : p_words)
+    {
+      result.cardinality += popcount(word);
+    }
+    if (result.cardinality > s_array_limit)
+    {
+      result.type = _type_t::bitmap;
+      result.words = p_words;
+      return result;
+    }
+    result.values.reserve(result.cardinality);
+    for (std::size_t i = 0; i < p_words.size(); ++i)
+    {
+      for (auto word = p_words[i]; 0 != word; word &= word - 1)
+      {
+        result.values.push_back(static_cast<uint16_t>(i * 64 + countr_zero(word)));
+      }
+    }
+    return result;
+  }
+
+  inline void roaring_bitmap::_normalize(_container& p_container)
+  {
+    if (_type_t::run == p_container.type)
+    {
+      p_container = _from_words(p_container.key, _to_words(p_container));
+    }
+  }
+
+  inline roaring_bitmap::_container roaring_bitmap::_or(const _container& p_lhs, const _container& p_rhs)
+  {
+    if (_type_t::array == p_lhs.type && _type_t::array == p_rhs.type &&
+      p_lhs.cardinality + p_rhs.cardinality <= s_array_limit)
+    {
+      _container result;
+      result.key = p_lhs.key;
+      std::set_union(p_lhs.values.cbegin(), p_lhs.values.cend(), p_rhs.values.cbegin(), p_rhs.values.cend(),
+        std::back_inserter(result.values));
+      result.cardinality = static_cast<uint32_t>(result.values.size());
+      return result;
+    }
+    auto words = _to_words(p_lhs);
+    _words_t temp;
+    const auto& other = _type_t::bitmap == p_rhs.type ? p_rhs.words : (temp = _to_words(p_rhs));
+    _roaring_or_words(words.data(), other.data(), s_bitmap_words);
+    return _from_words(p_lhs.key, words);
+  }
+
+  inline std::size_t roaring_bitmap::_payload_size(const _container& p_container) noexcept
+  {
+    return p_container.words.size() * sizeof(uint64_t) + p_container.values.size() * sizeof(uint16_t);
+  }
+
+  inline roaring_bitmap::_words_t roaring_bitmap::_to_words(const _container& p_container)
+  {
+    if (_type_t::bitmap == p_container.type)
+    {
+      return p_container.words;
+    }
+    _words_t result(s_bitmap_words);
+    auto function = [&result](uint16_t p_value)
+      {
+        result[p_value >> 6] |= 1ull << (p_value & 63u);
+      };
+    _for_each(p_container, function);
+    return result;
+  }
+
+  inline std::vector<roaring_bitmap::_container>::iterator roaring_bitmap::_find(uint16_t p_key)
+  {
+    return std::lower_bound(m_containers.begin(), m_containers.end(), p_key,
+      [](const _container& p_container, uint16_t p_value)
+      {
+        return p_container.key < p_value;
+      });
+  }
+
+  inline std::vector<roaring_bitmap::_container>::const_iterator roaring_bitmap::_find(uint16_t p_key) const
+  {
+    return std::lower_bound(m_containers.cbegin(), m_containers.cend(), p_key,
+      [](const _container& p_container, uint16_t p_value)
+      {
+        return p_container.key < p_value;
+      });
+  }
+
+  inline roaring_bitmap operator&(roaring_bitmap p_lhs, const roaring_bitmap& p_rhs)
+  {
+    return p_lhs &= p_rhs;
+  }
+
+  inline roaring_bitmap operator|(roaring_bitmap p_lhs, const roaring_bitmap& p_rhs)
+  {
+    return p_lhs |= p_rhs;
+  }
+
+  inline roaring_bitmap operator-(roaring_bitmap p_lhs, const roaring_bitmap& p_rhs)
+  {
+    return p_lhs -= p_rhs;
+  }
+
+  inline roaring_view::roaring_view(const uint8_t* p_data, std::size_t p_size)
+    : m_data(p_data),
+    m_count(0)
+  {
+    using _type_t = roaring_bitmap::_type_t;
+    if (nullptr == p_data || p_size < roaring_bitmap::s_serial_header_size ||
+      roaring_bitmap::s_serial_magic != _roaring_load32(p_data))
+    {
+      throw std::runtime_error("Invalid roaring bitmap header");
+    }
+    m_count = _roaring_load32(p_data + 4);
+    if ((p_size - roaring_bitmap::s_serial_header_size) / roaring_bitmap::s_serial_descriptor_size < m_count)
+    {
+      throw std::runtime_error("Invalid roaring bitmap size");
+    }
+    for (std::size_t i = 0; i < m_count; ++i)
+    {
+      auto descriptor = _descriptor(i);
+      auto type = static_cast<_type_t>(descriptor[2]);
+      uint64_t elements = _roaring_load32(descriptor + 4);
+      uint64_t offset = _roaring_load32(descriptor + 12);
+      uint64_t size = _type_t::bitmap == type ? elements * sizeof(uint64_t) :
+        _type_t::run == type ? elements * 2 * sizeof(uint16_t) : elements * sizeof(uint16_t);
+      if ((_type_t::array != type && _type_t::bitmap != type && _type_t::run != type) ||
+        (_type_t::bitmap == type && roaring_bitmap::s_bitmap_words != elements) || offset + size > p_size ||
+        (0 != i && _roaring_load16(_descriptor(i - 1)) >= _roaring_load16(descriptor)))
+      {
+        throw std::runtime_error("Invalid roaring bitmap container");
+      }
+    }
+  }
+
+  inline uint64_t roaring_view::cardinality(void) const noexcept
+  {
+    uint64_t result = 0;
+    for (std::size_t i = 0; i < m_count; ++i)
+    {
+      result += _roaring_load32(_descriptor(i) + 8);
+    }
+    return result;
+  }
+
+  inline bool roaring_view::contains(uint32_t p_value) const noexcept
+  {
+    using _type_t = roaring_bitmap::_type_t;
+    auto key = static_cast<uint16_t>(p_value >> 16);
+    auto value = static_cast<uint16_t>(p_value);
+    std::size_t low = 0;
+    std::size_t high = m_count;
+    while (low < high)
+    {
+      auto middle = low + (high - low) / 2;
+      if (_roaring_load16(_descriptor(middle)) < key)
+      {
+        low = middle + 1;
+      }
+      else
+      {
+        high = middle;
+      }
+    }
+    if (m_count == low || key != _roaring_load16(_descriptor(low)))
+    {
+      return false;
+    }
+    auto descriptor = _descriptor(low);
+    auto elements = _roaring_load32(descriptor + 4);
+    auto payload = m_data + _roaring_load32(descriptor + 12);
+    auto get = [payload](std::size_t p_index)
+      {
+        return _roaring_load16(payload + 2 * p_index);
+      };
+    switch (static_cast<_type_t>(descriptor[2]))
+    {
+    case _type_t::bitmap:
+      return 0 != (_roaring_load64(payload + 8 * (value >> 6)) >> (value & 63u) & 1u);
+    case _type_t::run:
+      return _roaring_run_contains(get, elements, value);
+    default:
+      return _roaring_array_contains(get, elements, value);
+    }
+  }
+
+  inline bool roaring_view::empty(void) const noexcept
+  {
+    return 0 == m_count;
+  }
+
+  inline const uint8_t* roaring_view::_descriptor(std::size_t p_index) const noexcept
+  {
+    return m_data + roaring_bitmap::s_serial_header_size + p_index * roaring_bitmap::s_serial_descriptor_size;
+  }
+#pragma endregion
+}
\ No newline at end of file
@@ -15,7 +15,10 @@
 namespace flib
 {
 #pragma region API
-  class timer
+  // Timer executing scheduled event on its own thread, where time of execution is determined by Clock (steady clock or
+  // steady clock based clock with cheaper now method, e.g. coarse_steady_clock from clock.hpp)
+  template<class Clock = std::chrono::steady_clock>
+  class basic_timer
   {
   public:
     using duration_t = std::chrono::nanoseconds;
@@ -28,19 +31,19 @@ namespace flib
     };
 
   public:
-    timer(void) = default;
-    timer(const timer&) = delete;
-    timer(timer&&) = delete;
-    ~timer(void) noexcept;
-    timer& operator=(const timer&) = delete;
-    timer& operator=(timer&&) = delete;
+    basic_timer(void) = default;
+    basic_timer(const basic_timer&) = delete;
+    basic_timer(basic_timer&&) = delete;
+    ~basic_timer(void) noexcept;
+    basic_timer& operator=(const basic_timer&) = delete;
+    basic_timer& operator=(basic_timer&&) = delete;
     void clear(void);
     void reschedule(void);
     void schedule(event_t p_event, duration_t p_delay, duration_t p_period = {}, type_t p_type = type_t::fixed_delay);
     bool scheduled(void) const;
 
   private:
-    using _clock_t = std::chrono::steady_clock;
+    using _clock_t = Clock;
 
     enum class _state_t
     {
@@ -63,27 +66,32 @@ namespace flib
     duration_t m_period{};
     type_t m_type{ type_t::fixed_delay };
     _state_t m_state{ _state_t::destruct };
-    _clock_t::time_point m_event_time;
-    std::unique_ptr<_executor> m_executor{ std::make_unique<timer::_executor>() };
+    typename _clock_t::time_point m_event_time;
+    std::unique_ptr<_executor> m_executor{ std::make_unique<basic_timer::_executor>() };
     std::condition_variable m_condition;
     mutable std::mutex m_condition_mtx;
   };
+
+  using timer = basic_timer<>;
 #pragma endregion
 
 #pragma region IMPLEMENTATION
-  struct timer::_executor
+  template<class Clock>
+  struct basic_timer<Clock>::_executor
   {
     bool m_running{ false };
     std::future<void> m_result;
   };
 
-  inline timer::~timer(void) noexcept
+  template<class Clock>
+  inline basic_timer<Clock>::~basic_timer(void) noexcept
   {
     clear();
     _wait(*m_executor);
   }
 
-  inline void timer::clear(void)
+  template<class Clock>
+  inline void basic_timer<Clock>::clear(void)
   {
     std::unique_lock<std::mutex> condition_guard(m_condition_mtx);
     m_state = _state_t::destruct;
@@ -91,7 +99,8 @@ namespace flib
     m_condition.notify_all();
   }
 
-  inline void timer::reschedule(void)
+  template<class Clock>
+  inline void basic_timer<Clock>::reschedule(void)
   {
     std::unique_lock<std::mutex> condition_guard(m_condition_mtx);
     if (!m_event)
@@ -105,7 +114,8 @@ namespace flib
     m_condition.notify_all();
   }
 
-  inline void timer::schedule(event_t p_event, duration_t p_delay, duration_t p_period, type_t p_type)
+  template<class Clock>
+  inline void basic_timer<Clock>::schedule(event_t p_event, duration_t p_delay, duration_t p_period, type_t p_type)
   {
     if (!p_event)
     {
@@ -123,27 +133,31 @@ namespace flib
     m_condition.notify_all();
   }
 
-  inline bool timer::scheduled(void) const
+  template<class Clock>
+  inline bool basic_timer<Clock>::scheduled(void) const
   {
     std::unique_lock<std::mutex> condition_guard(m_condition_mtx);
     return _state_t::active == m_state || _state_t::activating == m_state;
   }
 
-  inline bool timer::_condition_check(void) const
+  template<class Clock>
+  inline bool basic_timer<Clock>::_condition_check(void) const
   {
     return _state_t::active != m_state;
   }
 
-  inline void timer::_init(_executor& p_executor)
+  template<class Clock>
+  inline void basic_timer<Clock>::_init(_executor& p_executor)
   {
     if (!p_executor.m_running)
     {
       p_executor.m_running = true;
-      p_executor.m_result = std::async(std::launch::async, &timer::_run, this, std::ref(p_executor));
+      p_executor.m_result = std::async(std::launch::async, &basic_timer::_run, this, std::ref(p_executor));
     }
   }
 
-  inline void timer::_wait(_executor& p_executor)
+  template<class Clock>
+  inline void basic_timer<Clock>::_wait(_executor& p_executor)
   {
     if (p_executor.m_result.valid())
     {
@@ -151,16 +165,17 @@ namespace flib
     }
   }
 
-  inline void timer::_run(_executor& p_executor)
+  template<class Clock>
+  inline void basic_timer<Clock>::_run(_executor& p_executor)
   {
     try
     {
       event_t event;
-      _clock_t::time_point event_time;
+      typename _clock_t::time_point event_time;
       std::unique_lock<std::mutex> condition_guard(m_condition_mtx, std::defer_lock);
       auto scheduled_execution = [&]
         {
-          if (m_condition.wait_until(condition_guard, event_time, std::bind(&timer::_condition_check, this)))
+          if (m_condition.wait_until(condition_guard, event_time, std::bind(&basic_timer::_condition_check, this)))
           {
             return false;
           }
@@ -3,39 +3,234 @@
 
 #pragma once
 
+#include <atomic>
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <ctime>
 #include <cstdlib>
-#include <iomanip>
-#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 namespace flib
 {
   // RFC 3339 compliant timestamps with microsecond precision (if available)
   inline namespace timestamp
   {
+    // Maximum length of generated timestamp (e.g. "YYYY-MM-DDTHH:MM:SS.ffffff+HH:MM")
+    constexpr std::size_t max_length = 32;
+    // Maximum length of timestamp parsed with full precision (e.g. "YYYY-MM-DDTHH:MM:SS.fffffffff+HH:MM")
+    constexpr std::size_t max_parse_length = 35;
+
     std::string generate(const std::chrono::system_clock::time_point& timepoint = std::chrono::system_clock::now(),
       bool utc = true);
 
+    // Allocation-free variant of generate, writing timestamp into caller buffer (without null terminator)
+    //
+    // Returns number of written characters or 0 if buffer is too small or year is out of range [0, 9999]
+    std::size_t generate_to(char* buffer, std::size_t size,
+      const std::chrono::system_clock::time_point& timepoint = std::chrono::system_clock::now(), bool utc = true);
+
+    // Timestamp formatter caching formatted date, time and offset of last formatted second, so that only fractional
+    // part is written for timestamps within the same second. Not thread-safe - intended to be owned by caller or used
+    // as thread-local object.
+    class formatter
+    {
+    public:
+      explicit formatter(bool utc = true) noexcept;
+      std::string format(const std::chrono::system_clock::time_point& timepoint = std::chrono::system_clock::now());
+      std::size_t format_to(char* buffer, std::size_t size,
+        const std::chrono::system_clock::time_point& timepoint = std::chrono::system_clock::now());
+
+    private:
+      void _update(int64_t seconds);
+
+    private:
+      bool m_utc;
+      bool m_valid{ false };
+      int64_t m_seconds{ 0 };
+      uint64_t m_generation{ 0 };
+      std::size_t m_suffix_length{ 0 };
+      char m_prefix[19]{};
+      char m_suffix[6]{};
+    };
+
+    enum class precision_t
+    {
+      seconds = 0,
+      millis = 3,
+      micros = 6,
+      nanos = 9
+    };
+
+    enum class trim_t
+    {
+      no,
+      yes
+    };
+
+    enum class separator_t
+    {
+      t,
+      space
+    };
+
+    enum class style_t
+    {
+      extended, // YYYY-MM-DDTHH:MM:SS.fff+HH:MM
+      basic     // YYYYMMDDTHHMMSS.fff+HHMM
+    };
+
+    // Compile-time timestamp format specification, generating straight-line digit writer for each instantiation
+    //
+    // Without trimming of fractional trailing zeros, generated timestamps have fixed length (see length method)
+    template<precision_t Precision = precision_t::micros, trim_t Trim = trim_t::yes, separator_t Separator = separator_t::t,
+      style_t Style = style_t::extended>
+    struct format
+    {
+      static constexpr std::size_t length(bool utc = true);
+      static std::string generate(const std::chrono::system_clock::time_point& timepoint = std::chrono::system_clock::now(),
+        bool utc = true);
+      static std::size_t generate_to(char* buffer, std::size_t size,
+        const std::chrono::system_clock::time_point& timepoint = std::chrono::system_clock::now(), bool utc = true);
+    };
+
+    // Invalidates cached local timezone offsets of all threads (e.g. after change of TZ environment variable)
+    void reload_timezone();
+
+    enum class parse_status_t
+    {
+      ok,
+      invalid_format,
+      invalid_date,
+      invalid_time,
+      invalid_offset,
+      out_of_range
+    };
+
+    // Throws std::runtime_error if timestamp is malformed
     std::chrono::system_clock::time_point parse(const std::string& timestamp);
 
+    // Non-throwing and allocation-free variant of parse (fraction precision up to nanoseconds)
+    //
+    // Parsed time point is written only when parse_status_t::ok is returned
+    parse_status_t parse(const char* data, std::size_t size, std::chrono::system_clock::time_point& timepoint) noexcept;
+
+    // Bulk variant of non-throwing parse for columnar data (e.g. CSV or JSON columns). Rows matching layout (width,
+    // fraction digits and offset form) of first parsed row are validated in batches, while irregular rows fall back to
+    // scalar parsing. Sizes may be nullptr for null-terminated rows.
+    //
+    // Failed rows are marked in failed bitmap (bit i % 64 of word i / 64) if provided, while their time points are left
+    // unchanged
+    //
+    // Returns number of parsed rows
+    std::size_t parse_many(const char* const* begin, const char* const* end, const std::size_t* sizes,
+      std::chrono::system_clock::time_point* timepoints, uint64_t* failed = nullptr) noexcept;
+
+    // Strided variant of parse_many for count rows of given width, starting stride characters apart
+    std::size_t parse_many(const char* data, std::size_t width, std::size_t stride, std::size_t count,
+      std::chrono::system_clock::time_point* timepoints, uint64_t* failed = nullptr) noexcept;
+
+    // Length of binary timestamp
+    constexpr std::size_t binary_length = 8;
+
+    // Writes binary timestamp into buffer of binary_length bytes - big-endian ticks of given precision since epoch with
+    // flipped sign bit, so that comparison of binary timestamps with memcmp matches chronological order
+    void to_binary(uint8_t* buffer, const std::chrono::system_clock::time_point& timepoint,
+      precision_t precision = precision_t::micros) noexcept;
+
+    // Variant of to_binary, converting timestamp with non-throwing parse
+    parse_status_t to_binary(uint8_t* buffer, const char* data, std::size_t size,
+      precision_t precision = precision_t::micros) noexcept;
+
+    // Reads binary timestamp of binary_length bytes, returning parse_status_t::out_of_range if its ticks exceed
+    // range of nanoseconds since epoch
+    //
+    // Time point is written only when parse_status_t::ok is returned
+    parse_status_t from_binary(const uint8_t* buffer, std::chrono::system_clock::time_point& timepoint,
+      precision_t precision = precision_t::micros) noexcept;
+
+    // Variant of from_binary, generating timestamp with generate_to
+    //
+    // Returns number of written characters or 0 if buffer is too small or binary timestamp is out of range
+    std::size_t from_binary(char* buffer, std::size_t size, const uint8_t* binary,
+      precision_t precision = precision_t::micros, bool utc = true);
+
+    // Encodes sequence of time points as zigzag varint deltas of ticks of given precision (first delta relative to
+    // epoch), which takes 1-3 bytes per time point for sorted sequences of nearby time points
+    std::vector<uint8_t> encode_stream(const std::chrono::system_clock::time_point* begin,
+      const std::chrono::system_clock::time_point* end, precision_t precision = precision_t::micros);
+
+    // Throws std::runtime_error if stream is malformed
+    std::vector<std::chrono::system_clock::time_point> decode_stream(const uint8_t* data, std::size_t size,
+      precision_t precision = precision_t::micros);
+
     // IMPLEMENTATION
 
     namespace _impl
     {
+      struct _civil_t
+      {
+        int64_t year;
+        uint32_t month;
+        uint32_t day;
+      };
+
+      constexpr int64_t _floor_div(int64_t value, int64_t divisor)
+      {
+        return value / divisor - (value % divisor < 0 ? 1 : 0);
+      }
+
+      // Civil date from days since 1970-01-01 (proleptic gregorian calendar)
+      // Refer to: https://howardhinnant.github.io/date_algorithms.html#civil_from_days
+      constexpr _civil_t _civil_from_days(int64_t days)
+      {
+        days += 719468;
+        auto era = (days >= 0 ? days : days - 146096) / 146097;
+        auto doe = static_cast<uint32_t>(days - era * 146097);
+        auto yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+        auto doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+        auto mp = (5 * doy + 2) / 153;
+        auto month = mp < 10 ? mp + 3 : mp - 9;
+        return { static_cast<int64_t>(yoe) + era * 400 + (month <= 2 ? 1 : 0), month, doy - (153 * mp + 2) / 5 + 1 };
+      }
+
+      // Days since 1970-01-01 from civil date (proleptic gregorian calendar)
+      // Refer to: https://howardhinnant.github.io/date_algorithms.html#days_from_civil
+      constexpr int64_t _days_from_civil(int64_t year, uint32_t month, uint32_t day)
+      {
+        year -= month <= 2 ? 1 : 0;
+        auto era = (year >= 0 ? year : year - 399) / 400;
+        auto yoe = static_cast<uint32_t>(year - era * 400);
+        auto doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+        auto doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+        return era * 146097 + static_cast<int64_t>(doe) - 719468;
+      }
+
+      constexpr uint32_t _days_in_month(int64_t year, uint32_t month)
+      {
+        return 2 != month ? 30u | ((month >> 3 ^ month) & 1u) :
+          0 == year % 4 && (0 != year % 100 || 0 == year % 400) ? 29u : 28u;
+      }
+
       inline std::tm _time_t_tm_utc(std::time_t time)
       {
+        auto seconds = static_cast<int64_t>(time);
+        auto days = _floor_div(seconds, 86400);
+        auto day_seconds = static_cast<int>(seconds - days * 86400);
+        auto civil = _civil_from_days(days);
         std::tm result{};
-#if defined(_WIN32) && !defined(__CYGWIN__)
-        if (0 == gmtime_s(&result, &time)) return result;
-#else
-        if (0 != gmtime_r(&time, &result)) return result;
-        result.tm_isdst = -1;
-        (void)mktime(&result);
-#endif
-        throw std::runtime_error("Time to tm UTC conversion error");
+        result.tm_year = static_cast<int>(civil.year - 1900);
+        result.tm_mon = static_cast<int>(civil.month - 1);
+        result.tm_mday = static_cast<int>(civil.day);
+        result.tm_hour = day_seconds / 3600;
+        result.tm_min = day_seconds / 60 % 60;
+        result.tm_sec = day_seconds % 60;
+        result.tm_wday = static_cast<int>(days - _floor_div(days + 4, 7) * 7 + 4);
+        result.tm_yday = static_cast<int>(days - _days_from_civil(civil.year, 1, 1));
+        return result;
       }
 
       inline std::tm _time_t_tm_local(std::time_t time)
@@ -51,90 +246,816 @@ namespace flib
 
       inline std::time_t _tm_time_t_utc(std::tm time)
       {
-#if defined(_WIN32) && !defined(__CYGWIN__)
-        return _mkgmtime(&time);
+        auto year_carry = _floor_div(time.tm_mon, 12);
+        auto month = static_cast<uint32_t>(time.tm_mon - year_carry * 12 + 1);
+        auto days = _days_from_civil(time.tm_year + 1900 + year_carry, month, 1) + time.tm_mday - 1;
+        return static_cast<std::time_t>(((days * 24 + time.tm_hour) * 60 + time.tm_min) * 60 + time.tm_sec);
+      }
+
+      // Cached local timezone offset, valid for UTC seconds in range [start, end)
+      struct _tz_cache_t
+      {
+        int64_t start{ 0 };
+        int64_t end{ 0 };
+        int64_t offset{ 0 };
+        uint64_t generation{ 0 };
+      };
+
+      inline std::atomic<uint64_t>& _tz_generation()
+      {
+        static std::atomic<uint64_t> generation{ 1 };
+        return generation;
+      }
+
+      inline int64_t _tz_offset(int64_t seconds)
+      {
+        auto reference = static_cast<std::time_t>(seconds);
+        return static_cast<int64_t>(_tm_time_t_utc(_time_t_tm_local(reference))) - seconds;
+      }
+
+      // Determines offset validity range by probing weekly up to a year ahead (and a week back) and bisecting found
+      // transition, assuming timezone changes its offset at most once per week
+      inline void _tz_refresh(_tz_cache_t& cache, int64_t seconds, uint64_t generation)
+      {
+        static constexpr int64_t probe_step = 7 * 86400;
+        static constexpr int probe_count = 53;
+        auto offset = _tz_offset(seconds);
+        auto same = seconds;
+        auto different = seconds;
+        for (auto i = 0; i < probe_count && same == different; ++i)
+        {
+          different += probe_step;
+          if (offset == _tz_offset(different))
+          {
+            same = different;
+          }
+        }
+        while (different - same > 1)
+        {
+          auto middle = same + (different - same) / 2;
+          if (offset == _tz_offset(middle))
+          {
+            same = middle;
+          }
+          else
+          {
+            different = middle;
+          }
+        }
+        cache.end = same == different ? same + 1 : different;
+        same = seconds;
+        different = seconds - probe_step;
+        if (offset == _tz_offset(different))
+        {
+          same = different;
+        }
+        while (same - different > 1)
+        {
+          auto middle = different + (same - different) / 2;
+          if (offset == _tz_offset(middle))
+          {
+            same = middle;
+          }
+          else
+          {
+            different = middle;
+          }
+        }
+        cache.start = same;
+        cache.offset = offset;
+        cache.generation = generation;
+      }
+
+      inline int64_t _local_offset(int64_t seconds)
+      {
+        static thread_local _tz_cache_t cache;
+        auto generation = _tz_generation().load(std::memory_order_acquire);
+        if (generation != cache.generation || seconds < cache.start || cache.end <= seconds)
+        {
+          _tz_refresh(cache, seconds, generation);
+        }
+        return cache.offset;
+      }
+
+      constexpr char _digits[] =
+        "00010203040506070809"
+        "10111213141516171819"
+        "20212223242526272829"
+        "30313233343536373839"
+        "40414243444546474849"
+        "50515253545556575859"
+        "60616263646566676869"
+        "70717273747576777879"
+        "80818283848586878889"
+        "90919293949596979899";
+
+      inline char* _write2(char* out, uint32_t value)
+      {
+        std::memcpy(out, &_digits[2 * value], 2);
+        return out + 2;
+      }
+
+      // Writes date and time of given local seconds (year must be in range [0, 9999])
+      inline char* _write_date_time(char* out, int64_t local_seconds, bool basic, char separator)
+      {
+        auto days = _floor_div(local_seconds, 86400);
+        auto day_seconds = static_cast<uint32_t>(local_seconds - days * 86400);
+        auto civil = _civil_from_days(days);
+        out = _write2(out, static_cast<uint32_t>(civil.year / 100));
+        out = _write2(out, static_cast<uint32_t>(civil.year % 100));
+        if (!basic)
+        {
+          *out++ = '-';
+        }
+        out = _write2(out, civil.month);
+        if (!basic)
+        {
+          *out++ = '-';
+        }
+        out = _write2(out, civil.day);
+        *out++ = separator;
+        out = _write2(out, day_seconds / 3600);
+        if (!basic)
+        {
+          *out++ = ':';
+        }
+        out = _write2(out, day_seconds / 60 % 60);
+        if (!basic)
+        {
+          *out++ = ':';
+        }
+        return _write2(out, day_seconds % 60);
+      }
+
+      // Writes timezone offset designator, given in seconds
+      inline char* _write_offset(char* out, int64_t offset, bool basic)
+      {
+        auto minutes = offset / 60;
+        *out++ = 0 > minutes ? '-' : '+';
+        auto absolute = static_cast<uint32_t>(0 > minutes ? -minutes : minutes);
+        out = _write2(out, absolute / 60);
+        if (!basic)
+        {
+          *out++ = ':';
+        }
+        return _write2(out, absolute % 60);
+      }
+
+      inline bool _in_range(int64_t local_seconds)
+      {
+        // [0000-01-01T00:00:00, 9999-12-31T23:59:59]
+        return -62167219200ll <= local_seconds && local_seconds <= 253402300799ll;
+      }
+
+      // Little-endian 8 character load
+      inline uint64_t _load64(const char* data)
+      {
+        uint64_t result = 0;
+#if defined(_WIN32) | defined(__BYTE_ORDER__) & (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+        std::memcpy(&result, data, sizeof(result));
 #else
-        return timegm(&time);
+        for (auto i = 8; i > 0; --i)
+        {
+          result = result << 8 | static_cast<uint8_t>(data[i - 1]);
+        }
 #endif
+        return result;
+      }
+
+      // Checks whether 8 characters match pattern of digits (where mask byte is 0xff) and given separators
+      inline bool _match8(uint64_t value, uint64_t digit_mask, uint64_t separators)
+      {
+        auto digits = (value & digit_mask) | (0x3030303030303030ull & ~digit_mask);
+        return (value & ~digit_mask) == separators &&
+          ((digits & 0xf0f0f0f0f0f0f0f0ull) | ((digits + 0x0606060606060606ull) & 0xf0f0f0f0f0f0f0f0ull) >> 4) ==
+          0x3333333333333333ull;
+      }
+
+      inline uint32_t _read2(const char* data)
+      {
+        return static_cast<uint32_t>(data[0] - '0') * 10 + static_cast<uint32_t>(data[1] - '0');
+      }
+
+      inline bool _is_digit(char value)
+      {
+        return static_cast<uint8_t>(value - '0') < 10;
+      }
+
+      inline int64_t _fraction_scale(std::size_t digits)
+      {
+        static constexpr int64_t scale[] = { 1000000000, 100000000, 10000000, 1000000, 100000, 10000, 1000, 100, 10, 1 };
+        return scale[digits];
+      }
+
+      // Validates structure of "YYYY-MM-DDTHH:MM:SS" as "YYYY-MM-", "DDTHH:MM" and "HH:MM:SS" with lowercase 't' allowed
+      inline bool _match_date_time(const char* data)
+      {
+        return _match8(_load64(data), 0x00ffff00ffffffffull, 0x2d00002d00000000ull) &
+          _match8(_load64(data + 8) & ~0x0000000000200000ull, 0xffff00ffff00ffffull, 0x00003a0000540000ull) &
+          _match8(_load64(data + 11), 0xffff00ffff00ffffull, 0x00003a00003a0000ull);
+      }
+
+      // Converts structurally valid "YYYY-MM-DD" into days since epoch
+      inline parse_status_t _read_date(const char* data, int64_t& days)
+      {
+        int64_t year = _read2(data) * 100 + _read2(data + 2);
+        auto month = _read2(data + 5);
+        auto day = _read2(data + 8);
+        if (month < 1 || 12 < month || day < 1 || _days_in_month(year, month) < day)
+        {
+          return parse_status_t::invalid_date;
+        }
+        days = _days_from_civil(year, month, day);
+        return parse_status_t::ok;
+      }
+
+      // Converts structurally valid "HH:MM:SS" into seconds since midnight
+      inline parse_status_t _read_time(const char* data, int64_t& seconds)
+      {
+        auto hour = _read2(data);
+        auto minute = _read2(data + 3);
+        auto second = _read2(data + 6);
+        if (23 < hour || 59 < minute || 60 < second)
+        {
+          return parse_status_t::invalid_time;
+        }
+        seconds = hour * 3600 + minute * 60 + second;
+        return parse_status_t::ok;
+      }
+
+      // Converts structurally valid "+HH:MM" or "-HH:MM" into signed seconds
+      inline parse_status_t _read_offset(const char* data, int64_t& offset)
+      {
+        auto hour = _read2(data + 1);
+        auto minute = _read2(data + 4);
+        if (23 < hour || 59 < minute)
+        {
+          return parse_status_t::invalid_offset;
+        }
+        offset = (hour * 60 + minute) * 60;
+        offset = '+' == *data ? offset : -offset;
+        return parse_status_t::ok;
+      }
+
+      inline parse_status_t _make_timepoint(int64_t seconds, int64_t nanoseconds,
+        std::chrono::system_clock::time_point& timepoint)
+      {
+        using duration_t = std::chrono::system_clock::duration;
+        static constexpr auto limit = std::chrono::duration_cast<std::chrono::seconds>(duration_t::max()).count() - 1;
+        if (seconds < -limit || limit < seconds)
+        {
+          return parse_status_t::out_of_range;
+        }
+        timepoint = std::chrono::system_clock::time_point(std::chrono::duration_cast<duration_t>(
+          std::chrono::seconds(seconds) + std::chrono::nanoseconds(nanoseconds)));
+        return parse_status_t::ok;
+      }
+
+      // Fixed layout of timestamp column, derived from first parsed row, with date and offset of last converted row,
+      // which are usually shared by neighbouring rows of column
+      struct _layout_t
+      {
+        std::size_t width;
+        std::size_t fraction;
+        bool zulu;
+        bool cached;
+        uint64_t date_key[2];
+        uint64_t offset_key;
+        int64_t days;
+        int64_t offset;
+      };
+
+      inline bool _detect_layout(const char* data, std::size_t size, _layout_t& layout)
+      {
+        auto zulu = 'Z' == (data[size - 1] & ~0x20);
+        auto fraction = size - (zulu ? 20u : 25u);
+        fraction -= 0 != fraction ? 1 : 0;
+        if (9 < fraction)
+        {
+          return false;
+        }
+        layout = { size, fraction, zulu, false, {}, 0, 0, 0 };
+        return true;
+      }
+
+      // Branchless structural validation of row against layout, so that validation of several rows can be overlapped
+      inline bool _match_layout(const char* data, std::size_t size, const _layout_t& layout)
+      {
+        if (size != layout.width)
+        {
+          return false;
+        }
+        auto valid = _match_date_time(data);
+        auto it = data + 19;
+        if (0 != layout.fraction)
+        {
+          valid &= '.' == *it++;
+          for (auto end = it + layout.fraction; end != it; ++it)
+          {
+            valid &= _is_digit(*it);
+          }
+        }
+        if (layout.zulu)
+        {
+          return valid & ('Z' == (*it & ~0x20));
+        }
+        return valid & ('+' == it[0] || '-' == it[0]) & (':' == it[3]) & _is_digit(it[1]) & _is_digit(it[2]) &
+          _is_digit(it[4]) & _is_digit(it[5]);
+      }
+
+      inline bool _convert_layout(const char* data, _layout_t& layout, std::chrono::system_clock::time_point& timepoint)
+      {
+        // Date ("YYYY-MM-DD") and offset ("+HH:MM") are compared with previous row as 8-byte words
+        uint64_t date_key[2] = { _load64(data), _load64(data + 2) };
+        auto offset_key = layout.zulu ? 0 : _load64(data + layout.width - 8) >> 16;
+        if (!layout.cached || date_key[0] != layout.date_key[0] || date_key[1] != layout.date_key[1] ||
+          offset_key != layout.offset_key)
+        {
+          int64_t days = 0;
+          int64_t offset = 0;
+          if (parse_status_t::ok != _read_date(data, days) ||
+            (!layout.zulu && parse_status_t::ok != _read_offset(data + layout.width - 6, offset)))
+          {
+            return false;
+          }
+          layout.cached = true;
+          layout.date_key[0] = date_key[0];
+          layout.date_key[1] = date_key[1];
+          layout.offset_key = offset_key;
+          layout.days = days;
+          layout.offset = offset;
+        }
+        int64_t seconds = 0;
+        if (parse_status_t::ok != _read_time(data + 11, seconds))
+        {
+          return false;
+        }
+        int64_t nanoseconds = 0;
+        for (auto it = data + 20, end = it + layout.fraction; end != it; ++it)
+        {
+          nanoseconds = nanoseconds * 10 + (*it - '0');
+        }
+        nanoseconds *= _fraction_scale(layout.fraction);
+        return parse_status_t::ok == _make_timepoint(layout.days * 86400 + seconds - layout.offset, nanoseconds, timepoint);
+      }
+
+      // Parses rows in blocks, where rows of block are first validated against layout and converted if matching or
+      // parsed with scalar parse otherwise
+      template<class _Row>
+      inline std::size_t _parse_rows(std::size_t count, _Row row, std::chrono::system_clock::time_point* timepoints,
+        uint64_t* failed)
+      {
+        static constexpr std::size_t block = 4;
+        if (nullptr != failed)
+        {
+          std::memset(failed, 0, (count + 63) / 64 * sizeof(uint64_t));
+        }
+        _layout_t layout{ 0, 0, false, false, {}, 0, 0, 0 };
+        std::size_t parsed = 0;
+        for (std::size_t index = 0; index < count; index += block)
+        {
+          auto rows = count - index < block ? count - index : block;
+          const char* data[block]{};
+          std::size_t sizes[block]{};
+          bool matched[block]{};
+          for (std::size_t i = 0; i < rows; ++i)
+          {
+            data[i] = row(index + i, sizes[i]);
+            matched[i] = 0 != layout.width && nullptr != data[i] && _match_layout(data[i], sizes[i], layout);
+          }
+          for (std::size_t i = 0; i < rows; ++i)
+          {
+            auto& timepoint = timepoints[index + i];
+            bool ok = false;
+            if (matched[i])
+            {
+              ok = _convert_layout(data[i], layout, timepoint);
+            }
+            else if (parse_status_t::ok == parse(data[i], sizes[i], timepoint))
+            {
+              ok = true;
+              if (0 == layout.width)
+              {
+                _detect_layout(data[i], sizes[i], layout);
+              }
+            }
+            if (ok)
+            {
+              ++parsed;
+            }
+            else if (nullptr != failed)
+            {
+              failed[(index + i) / 64] |= 1ull << ((index + i) % 64);
+            }
+          }
+        }
+        return parsed;
+      }
+
+      inline int64_t _ticks(const std::chrono::system_clock::time_point& timepoint, precision_t precision)
+      {
+        return _floor_div(std::chrono::duration_cast<std::chrono::nanoseconds>(timepoint.time_since_epoch()).count(),
+          _fraction_scale(static_cast<std::size_t>(precision)));
+      }
+
+      // Returns false if ticks exceed range of nanoseconds since epoch
+      inline bool _from_ticks(int64_t ticks, precision_t precision, std::chrono::system_clock::time_point& timepoint)
+      {
+        auto scale = _fraction_scale(static_cast<std::size_t>(precision));
+        if (ticks > INT64_MAX / scale || ticks < INT64_MIN / scale)
+        {
+          return false;
+        }
+        timepoint = std::chrono::system_clock::time_point(
+          std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(ticks * scale)));
+        return true;
       }
     }
 
     inline std::string generate(const std::chrono::system_clock::time_point& timepoint, bool utc)
     {
-      auto reference = std::chrono::system_clock::to_time_t(timepoint);
-      auto time_struct = utc ? _impl::_time_t_tm_utc(reference) : _impl::_time_t_tm_local(reference);
-      std::ostringstream stream;
-      stream << std::put_time(&time_struct, "%FT%T");
+      char buffer[max_length];
+      auto length = generate_to(buffer, sizeof(buffer), timepoint, utc);
+      if (0 == length)
+      {
+        throw std::runtime_error("Timestamp out of range");
+      }
+      return std::string(buffer, length);
+    }
+
+    inline std::size_t generate_to(char* buffer, std::size_t size, const std::chrono::system_clock::time_point& timepoint,
+      bool utc)
+    {
+      static thread_local formatter utc_formatter(true);
+      static thread_local formatter local_formatter(false);
+      return (utc ? utc_formatter : local_formatter).format_to(buffer, size, timepoint);
+    }
+
+    inline formatter::formatter(bool utc) noexcept
+      : m_utc(utc)
+    {
+    }
+
+    inline std::string formatter::format(const std::chrono::system_clock::time_point& timepoint)
+    {
+      char buffer[max_length];
+      auto length = format_to(buffer, sizeof(buffer), timepoint);
+      if (0 == length)
+      {
+        throw std::runtime_error("Timestamp out of range");
+      }
+      return std::string(buffer, length);
+    }
+
+    inline std::size_t formatter::format_to(char* buffer, std::size_t size,
+      const std::chrono::system_clock::time_point& timepoint)
+    {
+      auto micros = std::chrono::duration_cast<std::chrono::microseconds>(timepoint.time_since_epoch()).count();
+      auto seconds = _impl::_floor_div(micros, 1000000);
+      auto fraction = static_cast<uint32_t>(micros - seconds * 1000000);
+      if (!m_valid || seconds != m_seconds ||
+        (!m_utc && m_generation != _impl::_tz_generation().load(std::memory_order_acquire)))
+      {
+        _update(seconds);
+      }
+      if (!m_valid)
+      {
+        return 0;
+      }
+      char temp[max_length];
+      std::memcpy(temp, m_prefix, sizeof(m_prefix));
+      auto out = temp + sizeof(m_prefix);
+      if (0 != fraction)
+      {
+        *out++ = '.';
+        out = _impl::_write2(out, fraction / 10000);
+        out = _impl::_write2(out, fraction / 100 % 100);
+        out = _impl::_write2(out, fraction % 100);
+        while ('0' == out[-1])
+        {
+          --out;
+        }
+      }
+      std::memcpy(out, m_suffix, m_suffix_length);
+      auto length = static_cast<std::size_t>(out - temp) + m_suffix_length;
+      if (size < length)
+      {
+        return 0;
+      }
+      std::memcpy(buffer, temp, length);
+      return length;
+    }
+
+    inline void formatter::_update(int64_t seconds)
+    {
+      m_seconds = seconds;
+      m_generation = _impl::_tz_generation().load(std::memory_order_acquire);
+      auto offset = m_utc ? 0 : _impl::_local_offset(seconds);
+      m_valid = _impl::_in_range(seconds + offset);
+      if (!m_valid)
+      {
+        return;
+      }
+      _impl::_write_date_time(m_prefix, seconds + offset, false, 'T');
+      if (m_utc)
+      {
+        m_suffix[0] = 'Z';
+        m_suffix_length = 1;
+        return;
+      }
+      _impl::_write_offset(m_suffix, offset, false);
+      m_suffix_length = 6;
+    }
+
+    template<precision_t Precision, trim_t Trim, separator_t Separator, style_t Style>
+    inline constexpr std::size_t format<Precision, Trim, Separator, Style>::length(bool utc)
+    {
+      return (style_t::basic == Style ? 15 : 19) +
+        (precision_t::seconds == Precision ? 0 : static_cast<std::size_t>(Precision) + 1) +
+        (utc ? 1 : style_t::basic == Style ? 5 : 6);
+    }
+
+    template<precision_t Precision, trim_t Trim, separator_t Separator, style_t Style>
+    inline std::string format<Precision, Trim, Separator, Style>::generate(const std::chrono::system_clock::time_point& timepoint,
+      bool utc)
+    {
+      char buffer[length(false)];
+      auto written = generate_to(buffer, sizeof(buffer), timepoint, utc);
+      if (0 == written)
       {
-        auto decimal = std::to_string(
-          std::chrono::duration_cast<std::chrono::microseconds>(timepoint.time_since_epoch()).count() % 1000000);
-        decimal = std::string(6 - decimal.size(), '0') + decimal;
-        auto pos = decimal.find_last_not_of('0');
-        decimal = std::string::npos != pos ? '.' + decimal.substr(0, pos + 1) : "";
-        stream << decimal;
+        throw std::runtime_error("Timestamp out of range");
+      }
+      return std::string(buffer, written);
+    }
+
+    template<precision_t Precision, trim_t Trim, separator_t Separator, style_t Style>
+    inline std::size_t format<Precision, Trim, Separator, Style>::generate_to(char* buffer, std::size_t size,
+      const std::chrono::system_clock::time_point& timepoint, bool utc)
+    {
+      static constexpr auto digits = static_cast<uint32_t>(Precision);
+      static constexpr auto basic = style_t::basic == Style;
+      auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(timepoint.time_since_epoch()).count();
+      auto seconds = _impl::_floor_div(nanos, 1000000000);
+      auto fraction = static_cast<uint32_t>(nanos - seconds * 1000000000);
+      auto offset = utc ? 0 : _impl::_local_offset(seconds);
+      if (!_impl::_in_range(seconds + offset))
+      {
+        return 0;
+      }
+      char temp[length(false)];
+      auto out = _impl::_write_date_time(temp, seconds + offset, basic, separator_t::space == Separator ? ' ' : 'T');
+      if (0 != digits)
+      {
+        for (auto i = digits; i < 9; ++i)
+        {
+          fraction /= 10;
+        }
+        *out = '.';
+        for (auto i = digits; i > 0; --i)
+        {
+          out[i] = static_cast<char>('0' + fraction % 10);
+          fraction /= 10;
+        }
+        out += digits + 1;
+        if (trim_t::yes == Trim)
+        {
+          while ('0' == out[-1])
+          {
+            --out;
+          }
+          if ('.' == out[-1])
+          {
+            --out;
+          }
+        }
       }
       if (utc)
       {
-        stream << 'Z';
-        return stream.str();
+        *out++ = 'Z';
+      }
+      else
+      {
+        out = _impl::_write_offset(out, offset, basic);
+      }
+      auto written = static_cast<std::size_t>(out - temp);
+      if (size < written)
+      {
+        return 0;
       }
-      auto tz_diff = std::chrono::duration_cast<std::chrono::minutes>(
-        std::chrono::system_clock::from_time_t(_impl::_tm_time_t_utc(time_struct) - reference).time_since_epoch());
-      auto tz_prefix = std::chrono::minutes::zero() > tz_diff ? '-' : '+';
-      auto tz_hour = std::abs(std::chrono::duration_cast<std::chrono::hours>(tz_diff).count());
-      auto tz_min = std::abs(tz_diff.count()) - tz_hour * 60;
-      stream << tz_prefix << std::setw(2) << std::setfill('0') << tz_hour << ':' << std::setw(2) << std::setfill('0')
-        << tz_min;
-      return stream.str();
+      std::memcpy(buffer, temp, written);
+      return written;
+    }
+
+    inline void reload_timezone()
+    {
+#if defined(_WIN32) && !defined(__CYGWIN__)
+      _tzset();
+#else
+      tzset();
+#endif
+      _impl::_tz_generation().fetch_add(1, std::memory_order_acq_rel);
     }
 
     inline std::chrono::system_clock::time_point parse(const std::string& timestamp)
     {
-      static const auto get_separator_type = [](int ch) -> int
+      std::chrono::system_clock::time_point result;
+      if (parse_status_t::ok != parse(timestamp.data(), timestamp.size(), result))
+      {
+        throw std::runtime_error("Timestamp parsing error");
+      }
+      return result;
+    }
+
+    inline parse_status_t parse(const char* data, std::size_t size, std::chrono::system_clock::time_point& timepoint) noexcept
+    {
+      if (nullptr == data || size < 20 || !_impl::_match_date_time(data))
+      {
+        return parse_status_t::invalid_format;
+      }
+      int64_t days = 0;
+      int64_t seconds = 0;
+      auto status = _impl::_read_date(data, days);
+      status = parse_status_t::ok == status ? _impl::_read_time(data + 11, seconds) : status;
+      if (parse_status_t::ok != status)
+      {
+        return status;
+      }
+      seconds += days * 86400;
+      auto it = data + 19;
+      auto end = data + size;
+      int64_t nanoseconds = 0;
+      if ('.' == *it)
       {
-        switch (ch)
+        auto start = ++it;
+        auto limit = end - start < 9 ? end : start + 9;
+        for (; limit != it && _impl::_is_digit(*it); ++it)
         {
-        case '.':
-          return 1; // decimal;
-        case 'Z':
-          return 2; // tz_zulu;
-        case '+':
-          return 3; // tz_positive;
-        case '-':
-          return 4; // tz_negative;
-        default:
-          return 0; // other;
+          nanoseconds = nanoseconds * 10 + (*it - '0');
         }
-      };
-      std::tm temp{};
-      std::istringstream stream(timestamp);
-      stream >> std::get_time(&temp, "%Y-%m-%dT%T");
-      temp.tm_isdst = -1;
-      auto timepoint = std::chrono::system_clock::from_time_t(_impl::_tm_time_t_utc(temp));
-      if (1 == get_separator_type(stream.peek()))
+        nanoseconds *= _impl::_fraction_scale(static_cast<std::size_t>(it - start));
+        while (end != it && _impl::_is_digit(*it))
+        {
+          ++it;
+        }
+        if (start == it || end == it)
+        {
+          return parse_status_t::invalid_format;
+        }
+      }
+      int64_t offset = 0;
+      if ('Z' == (*it & ~0x20))
       {
-        stream.ignore();
-        std::string decimal;
-        while (0 == get_separator_type(stream.peek()) && decimal.size() < 6)
+        ++it;
+      }
+      else if ('+' == *it || '-' == *it)
+      {
+        if (end - it < 6 || ':' != it[3] || !_impl::_is_digit(it[1]) || !_impl::_is_digit(it[2]) ||
+          !_impl::_is_digit(it[4]) || !_impl::_is_digit(it[5]))
         {
-          decimal += static_cast<std::string::value_type>(stream.get());
+          return parse_status_t::invalid_format;
         }
-        timepoint += std::chrono::microseconds(std::stoul(decimal + std::string(6 - decimal.size(), '0')));
-        while (0 == get_separator_type(stream.peek()))
+        status = _impl::_read_offset(it, offset);
+        if (parse_status_t::ok != status)
+        {
+          return status;
+        }
+        it += 6;
+      }
+      else
+      {
+        return parse_status_t::invalid_format;
+      }
+      if (end != it)
+      {
+        return parse_status_t::invalid_format;
+      }
+      return _impl::_make_timepoint(seconds - offset, nanoseconds, timepoint);
+    }
+
+    inline std::size_t parse_many(const char* const* begin, const char* const* end, const std::size_t* sizes,
+      std::chrono::system_clock::time_point* timepoints, uint64_t* failed) noexcept
+    {
+      if (nullptr == begin || end <= begin)
+      {
+        return 0;
+      }
+      return _impl::_parse_rows(static_cast<std::size_t>(end - begin), [begin, sizes](std::size_t index, std::size_t& size)
+        {
+          auto data = begin[index];
+          size = nullptr != sizes ? sizes[index] : nullptr != data ? std::strlen(data) : 0;
+          return data;
+        }, timepoints, failed);
+    }
+
+    inline std::size_t parse_many(const char* data, std::size_t width, std::size_t stride, std::size_t count,
+      std::chrono::system_clock::time_point* timepoints, uint64_t* failed) noexcept
+    {
+      if (nullptr == data)
+      {
+        count = 0;
+      }
+      return _impl::_parse_rows(count, [data, width, stride](std::size_t index, std::size_t& size)
+        {
+          size = width;
+          return data + index * stride;
+        }, timepoints, failed);
+    }
+
+    inline void to_binary(uint8_t* buffer, const std::chrono::system_clock::time_point& timepoint,
+      precision_t precision) noexcept
+    {
+      auto value = static_cast<uint64_t>(_impl::_ticks(timepoint, precision)) ^ 0x8000000000000000ull;
+      for (auto i = binary_length; i > 0; --i, value >>= 8)
+      {
+        buffer[i - 1] = static_cast<uint8_t>(value);
+      }
+    }
+
+    inline parse_status_t to_binary(uint8_t* buffer, const char* data, std::size_t size, precision_t precision) noexcept
+    {
+      std::chrono::system_clock::time_point timepoint;
+      auto status = parse(data, size, timepoint);
+      if (parse_status_t::ok == status)
+      {
+        to_binary(buffer, timepoint, precision);
+      }
+      return status;
+    }
+
+    inline parse_status_t from_binary(const uint8_t* buffer, std::chrono::system_clock::time_point& timepoint,
+      precision_t precision) noexcept
+    {
+      uint64_t value = 0;
+      for (std::size_t i = 0; i < binary_length; ++i)
+      {
+        value = value << 8 | buffer[i];
+      }
+      return _impl::_from_ticks(static_cast<int64_t>(value ^ 0x8000000000000000ull), precision, timepoint) ?
+        parse_status_t::ok : parse_status_t::out_of_range;
+    }
+
+    inline std::size_t from_binary(char* buffer, std::size_t size, const uint8_t* binary, precision_t precision, bool utc)
+    {
+      std::chrono::system_clock::time_point timepoint;
+      return parse_status_t::ok == from_binary(binary, timepoint, precision) ?
+        generate_to(buffer, size, timepoint, utc) : 0;
+    }
+
+    inline std::vector<uint8_t> encode_stream(const std::chrono::system_clock::time_point* begin,
+      const std::chrono::system_clock::time_point* end, precision_t precision)
+    {
+      std::vector<uint8_t> result;
+      result.reserve(static_cast<std::size_t>(end - begin) * 2);
+      int64_t previous = 0;
+      for (; end != begin; ++begin)
+      {
+        auto ticks = _impl::_ticks(*begin, precision);
+        auto delta = static_cast<uint64_t>(ticks) - static_cast<uint64_t>(previous);
+        auto value = delta << 1 ^ (0 != (delta >> 63) ? ~0ull : 0ull);
+        for (; value >= 0x80; value >>= 7)
         {
-          stream.ignore();
+          result.push_back(static_cast<uint8_t>(value | 0x80));
         }
+        result.push_back(static_cast<uint8_t>(value));
+        previous = ticks;
       }
-      if (2 == get_separator_type(stream.peek()))
+      return result;
+    }
+
+    inline std::vector<std::chrono::system_clock::time_point> decode_stream(const uint8_t* data, std::size_t size,
+      precision_t precision)
+    {
+      std::vector<std::chrono::system_clock::time_point> result;
+      uint64_t ticks = 0;
+      for (std::size_t i = 0; i < size;)
       {
-        return timepoint;
+        uint64_t value = 0;
+        for (unsigned shift = 0;; shift += 7)
+        {
+          if (size == i || 63 < shift)
+          {
+            throw std::runtime_error("Timestamp stream decoding error");
+          }
+          auto byte = data[i++];
+          // Last byte of 64-bit value carries single bit, so that further bits are not silently dropped
+          if (63 == shift && 0 != (byte & 0x7e))
+          {
+            throw std::runtime_error("Timestamp stream decoding error");
+          }
+          value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+          if (0 == (byte & 0x80))
+          {
+            break;
+          }
+        }
+        ticks += value >> 1 ^ (0 != (value & 1) ? ~0ull : 0ull);
+        result.emplace_back();
+        if (!_impl::_from_ticks(static_cast<int64_t>(ticks), precision, result.back()))
+        {
+          throw std::runtime_error("Timestamp stream decoding error");
+        }
       }
-      auto invert = 3 == get_separator_type(stream.get());
-      temp = {};
-      stream >> std::get_time(&temp, "%R");
-      auto offset = std::chrono::hours(temp.tm_hour) + std::chrono::minutes(temp.tm_min);
-      timepoint += invert ? -offset : offset;
-      return timepoint;
+      return result;
     }
   }
 }
\ No newline at end of file
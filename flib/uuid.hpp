@@ -3,84 +3,949 @@
 
 #pragma once
 
+#include <array>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
 #include <random>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
+
+#include <flib/random.hpp>
+
+#if !defined(FLIB_NO_SHA) & defined(__SHA__) & defined(__SSE4_1__)
+#  define FLIB_SHA
+#  include <immintrin.h>
+#endif
 
 namespace flib
 {
   inline namespace uuid
   {
+    // Optional macros:
+    //  - FLIB_NO_SHA ... disables use of SHA extensions in v5 uuid generation
+    //
+    // SHA extensions are used only when enabled for compilation (e.g. -msha -msse4.1 or -march=native for gcc/clang),
+    // otherwise portable SHA-1 implementation is used
+
     enum class version_t
     {
-      v4
+      v3 = 3, // MD5 hash of namespace and name
+      v4 = 4, // random
+      v5 = 5, // SHA-1 hash of namespace and name
+      v7 = 7  // unix millisecond timestamp, followed by per-thread monotonic counter and random bits
+    };
+
+    // Binary uuid with bytes in RFC 9562 (network) order, compared and hashed as two 64-bit words
+    //
+    // Ordering matches ordering of lowercase string form
+    struct uuid_t
+    {
+      std::array<uint8_t, 16> bytes;
     };
 
+    // Predefined namespaces for name-based uuids (RFC 9562)
+    constexpr uuid_t namespace_dns{ { { 0x6b, 0xa7, 0xb8, 0x10, 0x9d, 0xad, 0x11, 0xd1, 0x80, 0xb4, 0x00, 0xc0, 0x4f, 0xd4,
+      0x30, 0xc8 } } };
+    constexpr uuid_t namespace_url{ { { 0x6b, 0xa7, 0xb8, 0x11, 0x9d, 0xad, 0x11, 0xd1, 0x80, 0xb4, 0x00, 0xc0, 0x4f, 0xd4,
+      0x30, 0xc8 } } };
+    constexpr uuid_t namespace_oid{ { { 0x6b, 0xa7, 0xb8, 0x12, 0x9d, 0xad, 0x11, 0xd1, 0x80, 0xb4, 0x00, 0xc0, 0x4f, 0xd4,
+      0x30, 0xc8 } } };
+    constexpr uuid_t namespace_x500{ { { 0x6b, 0xa7, 0xb8, 0x14, 0x9d, 0xad, 0x11, 0xd1, 0x80, 0xb4, 0x00, 0xc0, 0x4f, 0xd4,
+      0x30, 0xc8 } } };
+
+    bool operator==(const uuid_t& lhs, const uuid_t& rhs) noexcept;
+    bool operator!=(const uuid_t& lhs, const uuid_t& rhs) noexcept;
+    bool operator<(const uuid_t& lhs, const uuid_t& rhs) noexcept;
+    bool operator<=(const uuid_t& lhs, const uuid_t& rhs) noexcept;
+    bool operator>(const uuid_t& lhs, const uuid_t& rhs) noexcept;
+    bool operator>=(const uuid_t& lhs, const uuid_t& rhs) noexcept;
+
+    // Uuids are generated with per-thread xoshiro256** generator, seeded once per thread from random device
+    //
+    // Throws std::invalid_argument for name-based versions (v3 or v5), which require name
     std::string generate(version_t version = version_t::v4);
 
+    void generate(uuid_t& uuid, version_t version = version_t::v4);
+
+    // Variants using per-thread generator of given type (satisfying UniformRandomBitGenerator requirements and either
+    // constructible from std::seed_seq, e.g. flib::wyrand or std::mt19937_64, or seeding itself on default construction,
+    // e.g. flib::secure_generator for unguessable uuids)
+    template<class Generator>
+    std::string generate(version_t version = version_t::v4);
+
+    template<class Generator>
+    void generate(uuid_t& uuid, version_t version = version_t::v4);
+
+    // Variant using caller generator
+    template<class Generator>
+    void generate(uuid_t& uuid, Generator& generator, version_t version = version_t::v4);
+
+    // Bulk variants, generating uuids into contiguous buffer (or their string forms, 36 characters each without
+    // separators or terminators) with per-thread xoshiro256** generator (throwing std::invalid_argument for name-based
+    // versions)
+    void generate_n(uuid_t* uuids, std::size_t count, version_t version = version_t::v4);
+
+    void generate_n(char* data, std::size_t count, version_t version = version_t::v4);
+
+    // Name-based variants (v3 or v5), deterministic for given namespace and name (other versions are generated as v5)
+    void generate(uuid_t& uuid, const uuid_t& name_space, const std::string& name, version_t version = version_t::v5);
+
+    void generate(uuid_t& uuid, const uuid_t& name_space, const char* name, std::size_t size,
+      version_t version = version_t::v5);
+
+    void generate_n(uuid_t* uuids, const uuid_t& name_space, const std::string* names, std::size_t count,
+      version_t version = version_t::v5);
+
     bool test(const std::string& uuid, version_t version = version_t::v4);
 
+    bool test(const uuid_t& uuid, version_t version = version_t::v4) noexcept;
+
+    // Lowercase string form ("xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx")
+    std::string to_string(const uuid_t& uuid);
+
+    // Throws std::runtime_error if uuid string is malformed (hex digits of any case are accepted regardless of version)
+    uuid_t from_string(const std::string& uuid);
+
+    // Allocation-free variant of to_string (without terminator)
+    void format_to(char (&data)[36], const uuid_t& uuid) noexcept;
+
+    // Allocation-free parsing of 36 characters (hex digits of any case), returning false if they are malformed or if
+    // version or variant mismatches
+    bool parse(const char* data, uuid_t& uuid, version_t version = version_t::v4) noexcept;
+
+    // Variant of parse, which also converts characters to lowercase string form in place (only if parsing succeeds)
+    bool normalize(char* data, uuid_t& uuid, version_t version = version_t::v4) noexcept;
+
+    // Compact ULID form (26 characters of uppercase Crockford base32), with lexicographic ordering matching ordering of
+    // uuids (and thus creation time ordering of v7 uuids)
+    std::string to_ulid(const uuid_t& uuid);
+
+    // Throws std::runtime_error if ULID string is malformed
+    uuid_t from_ulid(const std::string& ulid);
+
+    // Allocation-free variant of to_ulid (without terminator)
+    void format_ulid_to(char (&data)[26], const uuid_t& uuid) noexcept;
+
+    // Allocation-free parsing of 26 characters, returning false if they are malformed (Crockford base32 digits of any
+    // case, with I and L read as 1 and O read as 0, and leading digit at most 7), with validation taking same time
+    // regardless of position of malformed characters
+    bool parse_ulid(const char* data, uuid_t& uuid) noexcept;
+
+    // Creation time of v7 uuid (with millisecond precision)
+    std::chrono::system_clock::time_point extract_time(const uuid_t& uuid) noexcept;
+
     // IMPLEMENTATION
 
-    inline std::string generate(version_t /*version*/)
+    namespace _impl
     {
-      static constexpr char hex[] = { '0','1','2','3','4','5','6','7','8','9','a','b','c','d','e','f' };
-      static std::mt19937_64 generator([]()
+      // Big-endian 8 byte load
+      inline uint64_t _load64(const void* data)
+      {
+        uint64_t result = 0;
+#if defined(_MSC_VER)
+        std::memcpy(&result, data, sizeof(result));
+        result = _byteswap_uint64(result);
+#elif defined(__BYTE_ORDER__) & (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+        std::memcpy(&result, data, sizeof(result));
+        result = __builtin_bswap64(result);
+#else
+        for (auto i = 0; i < 8; ++i)
         {
-          return std::random_device()();
-        }());
-      static std::uniform_int_distribution<uint64_t> distribution;
-      uint64_t data[]{ distribution(generator),distribution(generator) };
-      std::string uuid("xxxxxxxx-xxxx-4xxx-yxxx-xxxxxxxxxxxx");
-      uint8_t i{ 0u };
-      for (decltype(uuid)::value_type& symbol : uuid)
+          result = result << 8 | static_cast<const uint8_t*>(data)[i];
+        }
+#endif
+        return result;
+      }
+
+      // Big-endian 8 byte store
+      inline void _store64(void* data, uint64_t value)
       {
-        if ('x' == symbol)
+#if defined(_MSC_VER)
+        value = _byteswap_uint64(value);
+        std::memcpy(data, &value, sizeof(value));
+#elif defined(__BYTE_ORDER__) & (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+        value = __builtin_bswap64(value);
+        std::memcpy(data, &value, sizeof(value));
+#else
+        for (auto i = 8; i > 0; --i, value >>= 8)
         {
-          symbol = hex[(data[i / 16] >> 4 * (i % 16)) % 16];
-          ++i;
+          static_cast<uint8_t*>(data)[i - 1] = static_cast<uint8_t>(value);
         }
-        else if ('y' == symbol)
+#endif
+      }
+
+      // Per-thread generator, seeded once per thread from random device
+      template<class Generator>
+      inline Generator& _generator(std::true_type /*seedable*/)
+      {
+        thread_local Generator generator([]()
+          {
+            std::random_device device;
+            std::seed_seq sequence{ device(), device(), device(), device(), device(), device(), device(), device() };
+            return Generator(sequence);
+          }());
+        return generator;
+      }
+
+      // Per-thread generator, which seeds itself
+      template<class Generator>
+      inline Generator& _generator(std::false_type /*seedable*/)
+      {
+        thread_local Generator generator;
+        return generator;
+      }
+
+      template<class Generator>
+      inline Generator& _generator(void)
+      {
+        return _generator<Generator>(std::is_constructible<Generator, std::seed_seq&>());
+      }
+
+      template<class Generator>
+      inline uint64_t _random64(Generator& generator, std::true_type /*full_range*/)
+      {
+        return static_cast<uint64_t>(generator());
+      }
+
+      template<class Generator>
+      inline uint64_t _random64(Generator& generator, std::false_type /*full_range*/)
+      {
+        return std::uniform_int_distribution<uint64_t>()(generator);
+      }
+
+      template<class Generator>
+      inline uint64_t _random64(Generator& generator)
+      {
+        return _random64(generator, std::integral_constant<bool, 0 == Generator::min() &&
+          UINT64_MAX == static_cast<uint64_t>(Generator::max())>());
+      }
+
+      inline uint8_t _version_bits(version_t version)
+      {
+        return static_cast<uint8_t>(static_cast<uint8_t>(version) << 4);
+      }
+
+      // Stores uuid words with version and RFC 9562 variant bits applied by masking
+      inline void _store(uuid_t& uuid, uint64_t high, uint64_t low, version_t version)
+      {
+        _store64(uuid.bytes.data(), (high & 0xffffffffffff0fffull) | static_cast<uint64_t>(version) << 12);
+        _store64(uuid.bytes.data() + 8, (low & 0x3fffffffffffffffull) | 0x8000000000000000ull);
+      }
+
+      struct _v7_state_t
+      {
+        uint64_t milliseconds;
+        uint64_t counter;
+      };
+
+      // Per-thread v7 state, shared by all generator types
+      inline _v7_state_t& _v7_state(void)
+      {
+        thread_local _v7_state_t state{ 0, 0 };
+        return state;
+      }
+
+      // Layout (RFC 9562 method 1): 48-bit unix milliseconds, version, 12 counter bits, variant, 30 counter bits,
+      // 32 random bits. Counter is randomly seeded with its top bit cleared at each new millisecond and incremented
+      // otherwise, while its overflow (or clock moving backwards) advances stored millisecond instead.
+      template<class Generator>
+      inline void _generate_v7(uuid_t& uuid, Generator& generator)
+      {
+        auto& state = _v7_state();
+        auto milliseconds = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::system_clock::now().time_since_epoch()).count());
+        if (milliseconds > state.milliseconds)
         {
-          symbol = hex[(data[i / 16] >> 4 * (i % 16)) % 4 + 8];
-          ++i;
+          state.milliseconds = milliseconds;
+          state.counter = _random64(generator) >> 23;
         }
+        else if (0 != (++state.counter >> 42))
+        {
+          ++state.milliseconds;
+          state.counter = _random64(generator) >> 23;
+        }
+        _store(uuid, state.milliseconds << 16 | state.counter >> 30,
+          (state.counter & 0x3fffffffull) << 32 | (_random64(generator) & 0xffffffffull), version_t::v7);
       }
-      return uuid;
-    }
 
-    inline bool test(const std::string& uuid, version_t /*version*/)
-    {                                             
-      static const std::string reference("xxxxxxxx-xxxx-4xxx-yxxx-xxxxxxxxxxxx");
-      if (uuid.size() != reference.size())
+      inline void _check_random_version(version_t version)
       {
-        return false;
+        if (version_t::v3 == version || version_t::v5 == version)
+        {
+          throw std::invalid_argument("Name-based uuid version requires name");
+        }
       }
-      for (decltype(reference)::size_type i = 0; i < reference.size(); ++i)
+
+      // Random uuids are generated with local copy of generator, so that its state stays in registers instead of
+      // being reloaded after every store (which may alias it)
+      template<class Generator>
+      inline void _generate_n(uuid_t* uuids, std::size_t count, Generator& generator, version_t version)
       {
-        if ('x' == reference[i])
+        _check_random_version(version);
+        if (version_t::v7 == version)
         {
-          if ((uuid[i] < '0' || '9' < uuid[i]) && (uuid[i] < 'a' || 'f' < uuid[i]) && (uuid[i] < 'A' || 'F' < uuid[i]))
+          for (; count > 0; --count, ++uuids)
           {
-            return false;
+            _generate_v7(*uuids, generator);
           }
+          return;
         }
-        else if ('y' == reference[i])
+        auto local = generator;
+        for (; count > 0; --count, ++uuids)
         {
-          if ('8' != uuid[i] && '9' != uuid[i] && 'a' != uuid[i] && 'b' != uuid[i] && 'A' != uuid[i] && 'B' != uuid[i])
+          auto high = _random64(local);
+          _store(*uuids, high, _random64(local), version_t::v4);
+        }
+        generator = local;
+      }
+
+      // Hex digits of 32-bit value stored as 8 characters, with nibbles spread into bytes and converted in parallel
+      inline void _format_hex(char* data, uint32_t value)
+      {
+        uint64_t nibbles = value;
+        nibbles = (nibbles | nibbles << 16) & 0x0000ffff0000ffffull;
+        nibbles = (nibbles | nibbles << 8) & 0x00ff00ff00ff00ffull;
+        nibbles = (nibbles | nibbles << 4) & 0x0f0f0f0f0f0f0f0full;
+        // Nibbles above 9 are offset by 'a' - '0' - 10
+        auto letters = (nibbles + 0x0606060606060606ull) >> 4 & 0x0101010101010101ull;
+        _store64(data, nibbles + 0x3030303030303030ull + letters * 39);
+      }
+
+      // Lowercase string form written to 36 characters
+      inline void _format(char* data, const uuid_t& uuid)
+      {
+        auto high = _load64(uuid.bytes.data());
+        auto low = _load64(uuid.bytes.data() + 8);
+        char middle[16];
+        _format_hex(data, static_cast<uint32_t>(high >> 32));
+        _format_hex(middle, static_cast<uint32_t>(high));
+        _format_hex(middle + 8, static_cast<uint32_t>(low >> 32));
+        _format_hex(data + 28, static_cast<uint32_t>(low));
+        data[8] = '-';
+        std::memcpy(data + 9, middle, 4);
+        data[13] = '-';
+        std::memcpy(data + 14, middle + 4, 4);
+        data[18] = '-';
+        std::memcpy(data + 19, middle + 8, 4);
+        data[23] = '-';
+        std::memcpy(data + 24, middle + 12, 4);
+      }
+
+      // Bytes within [low, high] range, marked by their top bit (all bytes must be below 0x80)
+      inline uint64_t _in_range(uint64_t bytes, uint8_t low, uint8_t high)
+      {
+        auto not_below = bytes + 0x0101010101010101ull * static_cast<uint8_t>(0x80 - low);
+        auto above = bytes + 0x0101010101010101ull * static_cast<uint8_t>(0x7f - high);
+        return not_below & ~above & 0x8080808080808080ull;
+      }
+
+      // 8 hex digits converted to 32-bit value, with all characters validated and converted in parallel
+      inline bool _parse_hex(const char* data, uint32_t& value)
+      {
+        auto symbols = _load64(data);
+        auto letters = _in_range(symbols | 0x2020202020202020ull, 'a', 'f');
+        if (0 != (symbols & 0x8080808080808080ull) ||
+          0x8080808080808080ull != (_in_range(symbols, '0', '9') | letters))
+        {
+          return false;
+        }
+        // Letters are offset by 9, as low nibble of both 'a' and 'A' is 1
+        auto nibbles = (symbols & 0x0f0f0f0f0f0f0f0full) + (letters >> 7) * 9;
+        nibbles = (nibbles | nibbles >> 4) & 0x00ff00ff00ff00ffull;
+        nibbles = (nibbles | nibbles >> 8) & 0x0000ffff0000ffffull;
+        value = static_cast<uint32_t>(nibbles | nibbles >> 16);
+        return true;
+      }
+
+      // String form parsed as two words, with hyphen positions and hex digits validated
+      inline bool _parse(const char* data, uint64_t& high, uint64_t& low)
+      {
+        char middle[16];
+        std::memcpy(middle, data + 9, 4);
+        std::memcpy(middle + 4, data + 14, 4);
+        std::memcpy(middle + 8, data + 19, 4);
+        std::memcpy(middle + 12, data + 24, 4);
+        uint32_t words[4];
+        auto hyphens = ('-' == data[8]) & ('-' == data[13]) & ('-' == data[18]) & ('-' == data[23]);
+        if (!hyphens || !_parse_hex(data, words[0]) || !_parse_hex(middle, words[1]) ||
+          !_parse_hex(middle + 8, words[2]) || !_parse_hex(data + 28, words[3]))
+        {
+          return false;
+        }
+        high = static_cast<uint64_t>(words[0]) << 32 | words[1];
+        low = static_cast<uint64_t>(words[2]) << 32 | words[3];
+        return true;
+      }
+
+      inline bool _parse(const char* data, uuid_t& uuid, version_t version)
+      {
+        uint64_t high = 0;
+        uint64_t low = 0;
+        if (!_parse(data, high, low) || static_cast<uint64_t>(version) != (high >> 12 & 0x0f) || 2 != low >> 62)
+        {
+          return false;
+        }
+        _store64(uuid.bytes.data(), high);
+        _store64(uuid.bytes.data() + 8, low);
+        return true;
+      }
+
+      // Byte-wise comparison of values below 0x80 with constant, marked by lowest bit
+      inline uint64_t _at_least(uint64_t bytes, uint8_t value)
+      {
+        return (bytes + 0x0101010101010101ull * static_cast<uint8_t>(0x80 - value)) >> 7 & 0x0101010101010101ull;
+      }
+
+      // Base32 digits of 40-bit value stored as 8 characters, with 5-bit groups spread into bytes and converted in
+      // parallel (alphabet skips I, L, O and U)
+      inline void _format_base32(char* data, uint64_t value)
+      {
+        auto digits = (value & 0x00000000000fffffull) | (value & 0x000000fffff00000ull) << 12;
+        digits = (digits & 0x000003ff000003ffull) | (digits & 0x000ffc00000ffc00ull) << 6;
+        digits = (digits & 0x001f001f001f001full) | (digits & 0x03e003e003e003e0ull) << 3;
+        auto symbols = digits + 0x3030303030303030ull + _at_least(digits, 10) * 7 + _at_least(digits, 18) +
+          _at_least(digits, 20) + _at_least(digits, 22) + _at_least(digits, 27);
+        _store64(data, symbols);
+      }
+
+      // ULID form written to 26 characters, with leading 8 bits padded to 10 bits
+      inline void _format_ulid(char* data, const uuid_t& uuid)
+      {
+        auto high = _load64(uuid.bytes.data());
+        auto low = _load64(uuid.bytes.data() + 8);
+        char leading[8];
+        _format_base32(leading, high >> 56);
+        std::memcpy(data, leading + 6, 2);
+        _format_base32(data + 2, high >> 16 & 0xffffffffffull);
+        _format_base32(data + 10, (high & 0xffff) << 24 | low >> 40);
+        _format_base32(data + 18, low & 0xffffffffffull);
+      }
+
+      // Values of base32 digits by character (accepting lowercase letters and aliases of 0 and 1), with 0x20 marking
+      // invalid characters
+      struct _base32_values_t
+      {
+        uint8_t values[256];
+
+        constexpr _base32_values_t()
+          : values{}
+        {
+          for (auto& value : values)
           {
-            return false;
+            value = 0x20;
           }
+          const char alphabet[] = "0123456789ABCDEFGHJKMNPQRSTVWXYZ";
+          for (uint8_t i = 0; i < 32; ++i)
+          {
+            values[static_cast<uint8_t>(alphabet[i])] = i;
+            values[static_cast<uint8_t>(alphabet[i] | 0x20)] = i;
+          }
+          values['I'] = values['i'] = values['L'] = values['l'] = 1;
+          values['O'] = values['o'] = 0;
         }
-        else
+      };
+
+      // ULID form parsed as two words, with all characters looked up and validated regardless of earlier failures
+      inline bool _parse_ulid(const char* data, uint64_t& high, uint64_t& low)
+      {
+        static constexpr _base32_values_t table;
+        const auto values = table.values;
+        const auto symbols = reinterpret_cast<const uint8_t*>(data);
+        auto leading = values[symbols[0]];
+        auto errors = static_cast<uint8_t>(leading | values[symbols[1]]);
+        uint64_t first = 0;
+        uint64_t second = 0;
+        uint64_t third = 0;
+        // Groups of 8 characters are accumulated together, as they are independent
+        for (auto i = symbols + 2; i < symbols + 10; ++i)
         {
-          if (reference[i] != uuid[i])
+          errors = static_cast<uint8_t>(errors | values[i[0]] | values[i[8]] | values[i[16]]);
+          first = first << 5 | values[i[0]];
+          second = second << 5 | values[i[8]];
+          third = third << 5 | values[i[16]];
+        }
+        high = static_cast<uint64_t>(leading) << 61 | static_cast<uint64_t>(values[symbols[1]]) << 56 | first << 16 |
+          second >> 24;
+        low = second << 40 | third;
+        return 0 == ((errors & 0x20) | (leading & 0x18));
+      }
+
+      inline uint32_t _load32_big(const uint8_t* data)
+      {
+        return static_cast<uint32_t>(data[0]) << 24 | static_cast<uint32_t>(data[1]) << 16 |
+          static_cast<uint32_t>(data[2]) << 8 | data[3];
+      }
+
+      inline uint32_t _load32_little(const uint8_t* data)
+      {
+        return static_cast<uint32_t>(data[3]) << 24 | static_cast<uint32_t>(data[2]) << 16 |
+          static_cast<uint32_t>(data[1]) << 8 | data[0];
+      }
+
+      inline uint32_t _rotate_left(uint32_t value, int shift)
+      {
+        return value << shift | value >> (32 - shift);
+      }
+
+      // SHA-1 compression of 64 byte blocks (FIPS 180-4)
+      inline void _sha1_portable(uint32_t (&state)[5], const uint8_t* data, std::size_t blocks)
+      {
+        for (; blocks > 0; --blocks, data += 64)
+        {
+          uint32_t words[80];
+          for (auto i = 0; i < 16; ++i)
           {
-            return false;
+            words[i] = _load32_big(data + 4 * i);
           }
+          for (auto i = 16; i < 80; ++i)
+          {
+            words[i] = _rotate_left(words[i - 3] ^ words[i - 8] ^ words[i - 14] ^ words[i - 16], 1);
+          }
+          auto a = state[0];
+          auto b = state[1];
+          auto c = state[2];
+          auto d = state[3];
+          auto e = state[4];
+          auto round = [&a, &b, &c, &d, &e](uint32_t function, uint32_t word)
+            {
+              auto temp = _rotate_left(a, 5) + function + e + word;
+              e = d;
+              d = c;
+              c = _rotate_left(b, 30);
+              b = a;
+              a = temp;
+            };
+          for (auto i = 0; i < 20; ++i)
+          {
+            round((b & c) | (~b & d), words[i] + 0x5a827999);
+          }
+          for (auto i = 20; i < 40; ++i)
+          {
+            round(b ^ c ^ d, words[i] + 0x6ed9eba1);
+          }
+          for (auto i = 40; i < 60; ++i)
+          {
+            round((b & c) | (b & d) | (c & d), words[i] + 0x8f1bbcdc);
+          }
+          for (auto i = 60; i < 80; ++i)
+          {
+            round(b ^ c ^ d, words[i] + 0xca62c1d6);
+          }
+          state[0] += a;
+          state[1] += b;
+          state[2] += c;
+          state[3] += d;
+          state[4] += e;
         }
       }
+
+#if defined(FLIB_SHA)
+      // Group of 4 SHA-1 rounds with SHA extensions, which also extends message schedule for following groups
+      template<int Group>
+      inline void _sha1_group(__m128i& abcd, __m128i& e, __m128i& next_e, __m128i (&messages)[4], const uint8_t* data)
+      {
+        auto& message = messages[Group % 4];
+        if (Group < 4)
+        {
+          message = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16 * Group)),
+            _mm_set_epi64x(0x0001020304050607ll, 0x08090a0b0c0d0e0fll));
+        }
+        e = 0 == Group ? _mm_add_epi32(e, message) : _mm_sha1nexte_epu32(e, message);
+        next_e = abcd;
+        if (3 <= Group && Group <= 18)
+        {
+          messages[(Group + 1) % 4] = _mm_sha1msg2_epu32(messages[(Group + 1) % 4], message);
+        }
+        abcd = _mm_sha1rnds4_epu32(abcd, e, Group / 5);
+        if (1 <= Group && Group <= 16)
+        {
+          messages[(Group + 3) % 4] = _mm_sha1msg1_epu32(messages[(Group + 3) % 4], message);
+        }
+        if (2 <= Group && Group <= 17)
+        {
+          messages[(Group + 2) % 4] = _mm_xor_si128(messages[(Group + 2) % 4], message);
+        }
+      }
+
+      // SHA-1 compression of 64 byte blocks with SHA extensions
+      inline void _sha1(uint32_t (&state)[5], const uint8_t* data, std::size_t blocks)
+      {
+        auto abcd = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)), 0x1b);
+        auto e0 = _mm_set_epi32(static_cast<int>(state[4]), 0, 0, 0);
+        for (; blocks > 0; --blocks, data += 64)
+        {
+          auto abcd_saved = abcd;
+          auto e0_saved = e0;
+          auto e1 = abcd;
+          __m128i messages[4]{};
+          _sha1_group<0>(abcd, e0, e1, messages, data);
+          _sha1_group<1>(abcd, e1, e0, messages, data);
+          _sha1_group<2>(abcd, e0, e1, messages, data);
+          _sha1_group<3>(abcd, e1, e0, messages, data);
+          _sha1_group<4>(abcd, e0, e1, messages, data);
+          _sha1_group<5>(abcd, e1, e0, messages, data);
+          _sha1_group<6>(abcd, e0, e1, messages, data);
+          _sha1_group<7>(abcd, e1, e0, messages, data);
+          _sha1_group<8>(abcd, e0, e1, messages, data);
+          _sha1_group<9>(abcd, e1, e0, messages, data);
+          _sha1_group<10>(abcd, e0, e1, messages, data);
+          _sha1_group<11>(abcd, e1, e0, messages, data);
+          _sha1_group<12>(abcd, e0, e1, messages, data);
+          _sha1_group<13>(abcd, e1, e0, messages, data);
+          _sha1_group<14>(abcd, e0, e1, messages, data);
+          _sha1_group<15>(abcd, e1, e0, messages, data);
+          _sha1_group<16>(abcd, e0, e1, messages, data);
+          _sha1_group<17>(abcd, e1, e0, messages, data);
+          _sha1_group<18>(abcd, e0, e1, messages, data);
+          _sha1_group<19>(abcd, e1, e0, messages, data);
+          e0 = _mm_sha1nexte_epu32(e0, e0_saved);
+          abcd = _mm_add_epi32(abcd, abcd_saved);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(state), _mm_shuffle_epi32(abcd, 0x1b));
+        state[4] = static_cast<uint32_t>(_mm_extract_epi32(e0, 3));
+      }
+#else
+      inline void _sha1(uint32_t (&state)[5], const uint8_t* data, std::size_t blocks)
+      {
+        _sha1_portable(state, data, blocks);
+      }
+#endif
+
+      // MD5 compression of 64 byte blocks (RFC 1321)
+      inline void _md5(uint32_t (&state)[4], const uint8_t* data, std::size_t blocks)
+      {
+        static constexpr uint32_t constants[] = {
+          0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+          0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be, 0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+          0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+          0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+          0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c, 0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+          0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+          0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+          0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1, 0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391 };
+        static constexpr int shifts[] = { 7, 12, 17, 22, 5, 9, 14, 20, 4, 11, 16, 23, 6, 10, 15, 21 };
+        for (; blocks > 0; --blocks, data += 64)
+        {
+          uint32_t words[16];
+          for (auto i = 0; i < 16; ++i)
+          {
+            words[i] = _load32_little(data + 4 * i);
+          }
+          auto a = state[0];
+          auto b = state[1];
+          auto c = state[2];
+          auto d = state[3];
+          auto round = [&a, &b, &c, &d, &words](int i, uint32_t function, int word)
+            {
+              auto temp = d;
+              d = c;
+              c = b;
+              b += _rotate_left(a + function + constants[i] + words[word], shifts[i / 16 * 4 + i % 4]);
+              a = temp;
+            };
+          for (auto i = 0; i < 16; ++i)
+          {
+            round(i, (b & c) | (~b & d), i);
+          }
+          for (auto i = 16; i < 32; ++i)
+          {
+            round(i, (d & b) | (~d & c), (5 * i + 1) % 16);
+          }
+          for (auto i = 32; i < 48; ++i)
+          {
+            round(i, b ^ c ^ d, (3 * i + 5) % 16);
+          }
+          for (auto i = 48; i < 64; ++i)
+          {
+            round(i, c ^ (b | ~d), 7 * i % 16);
+          }
+          state[0] += a;
+          state[1] += b;
+          state[2] += c;
+          state[3] += d;
+        }
+      }
+
+      // Merkle-Damgard padding of namespace followed by name, with length stored in big or little endian order
+      template<std::size_t Size, class Compress>
+      inline void _hash(uint32_t (&state)[Size], const uuid_t& name_space, const char* name, std::size_t size,
+        bool big_endian, Compress compress)
+      {
+        auto bits = static_cast<uint64_t>(16 + size) * 8;
+        uint8_t block[64];
+        std::memcpy(block, name_space.bytes.data(), 16);
+        auto count = size < 48 ? size : 48;
+        std::memcpy(block + 16, name, count);
+        std::size_t used = 16 + count;
+        if (64 == used)
+        {
+          compress(state, block, 1);
+          auto data = reinterpret_cast<const uint8_t*>(name) + count;
+          size -= count;
+          compress(state, data, size / 64);
+          used = size % 64;
+          std::memcpy(block, data + size - used, used);
+        }
+        block[used++] = 0x80;
+        if (used > 56)
+        {
+          std::memset(block + used, 0, 64 - used);
+          compress(state, block, 1);
+          used = 0;
+        }
+        std::memset(block + used, 0, 56 - used);
+        for (auto i = 0; i < 8; ++i)
+        {
+          block[big_endian ? 63 - i : 56 + i] = static_cast<uint8_t>(bits >> 8 * i);
+        }
+        compress(state, block, 1);
+      }
+
+      inline void _generate_named(uuid_t& uuid, const uuid_t& name_space, const char* name, std::size_t size,
+        version_t version)
+      {
+        if (version_t::v3 == version)
+        {
+          uint32_t state[4] = { 0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476 };
+          _hash(state, name_space, name, size, false, _md5);
+          // MD5 digest consists of little-endian words
+          uint8_t digest[16];
+          for (auto i = 0; i < 16; ++i)
+          {
+            digest[i] = static_cast<uint8_t>(state[i / 4] >> 8 * (i % 4));
+          }
+          _store(uuid, _load64(digest), _load64(digest + 8), version);
+          return;
+        }
+        uint32_t state[5] = { 0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0 };
+        _hash(state, name_space, name, size, true, _sha1);
+        _store(uuid, static_cast<uint64_t>(state[0]) << 32 | state[1], static_cast<uint64_t>(state[2]) << 32 | state[3],
+          version_t::v5);
+      }
+    }
+
+    inline bool operator==(const uuid_t& lhs, const uuid_t& rhs) noexcept
+    {
+      return _impl::_load64(lhs.bytes.data()) == _impl::_load64(rhs.bytes.data()) &&
+        _impl::_load64(lhs.bytes.data() + 8) == _impl::_load64(rhs.bytes.data() + 8);
+    }
+
+    inline bool operator!=(const uuid_t& lhs, const uuid_t& rhs) noexcept
+    {
+      return !(lhs == rhs);
+    }
+
+    inline bool operator<(const uuid_t& lhs, const uuid_t& rhs) noexcept
+    {
+      auto lhs_high = _impl::_load64(lhs.bytes.data());
+      auto rhs_high = _impl::_load64(rhs.bytes.data());
+      return lhs_high < rhs_high || (lhs_high == rhs_high && _impl::_load64(lhs.bytes.data() + 8) <
+        _impl::_load64(rhs.bytes.data() + 8));
+    }
+
+    inline bool operator<=(const uuid_t& lhs, const uuid_t& rhs) noexcept
+    {
+      return !(rhs < lhs);
+    }
+
+    inline bool operator>(const uuid_t& lhs, const uuid_t& rhs) noexcept
+    {
+      return rhs < lhs;
+    }
+
+    inline bool operator>=(const uuid_t& lhs, const uuid_t& rhs) noexcept
+    {
+      return !(lhs < rhs);
+    }
+
+    inline std::string generate(version_t version)
+    {
+      return generate<xoshiro256ss>(version);
+    }
+
+    inline void generate(uuid_t& uuid, version_t version)
+    {
+      generate(uuid, _impl::_generator<xoshiro256ss>(), version);
+    }
+
+    template<class Generator>
+    inline std::string generate(version_t version)
+    {
+      uuid_t uuid;
+      generate(uuid, _impl::_generator<Generator>(), version);
+      return to_string(uuid);
+    }
+
+    template<class Generator>
+    inline void generate(uuid_t& uuid, version_t version)
+    {
+      generate(uuid, _impl::_generator<Generator>(), version);
+    }
+
+    template<class Generator>
+    inline void generate(uuid_t& uuid, Generator& generator, version_t version)
+    {
+      _impl::_check_random_version(version);
+      if (version_t::v7 == version)
+      {
+        _impl::_generate_v7(uuid, generator);
+        return;
+      }
+      auto high = _impl::_random64(generator);
+      _impl::_store(uuid, high, _impl::_random64(generator), version_t::v4);
+    }
+
+    inline void generate_n(uuid_t* uuids, std::size_t count, version_t version)
+    {
+      _impl::_generate_n(uuids, count, _impl::_generator<xoshiro256ss>(), version);
+    }
+
+    inline void generate_n(char* data, std::size_t count, version_t version)
+    {
+      static constexpr std::size_t block_size = 64;
+      uuid_t uuids[block_size];
+      while (count > 0)
+      {
+        auto size = count < block_size ? count : block_size;
+        _impl::_generate_n(uuids, size, _impl::_generator<xoshiro256ss>(), version);
+        for (std::size_t i = 0; i < size; ++i, data += 36)
+        {
+          _impl::_format(data, uuids[i]);
+        }
+        count -= size;
+      }
+    }
+
+    inline void generate(uuid_t& uuid, const uuid_t& name_space, const std::string& name, version_t version)
+    {
+      _impl::_generate_named(uuid, name_space, name.data(), name.size(), version);
+    }
+
+    inline void generate(uuid_t& uuid, const uuid_t& name_space, const char* name, std::size_t size, version_t version)
+    {
+      _impl::_generate_named(uuid, name_space, name, size, version);
+    }
+
+    inline void generate_n(uuid_t* uuids, const uuid_t& name_space, const std::string* names, std::size_t count,
+      version_t version)
+    {
+      for (; count > 0; --count, ++uuids, ++names)
+      {
+        _impl::_generate_named(*uuids, name_space, names->data(), names->size(), version);
+      }
+    }
+
+    inline bool test(const std::string& uuid, version_t version)
+    {
+      uuid_t result;
+      return 36 == uuid.size() && _impl::_parse(uuid.data(), result, version);
+    }
+
+    inline bool test(const uuid_t& uuid, version_t version) noexcept
+    {
+      return _impl::_version_bits(version) == (uuid.bytes[6] & 0xf0) && 0x80 == (uuid.bytes[8] & 0xc0);
+    }
+
+    inline std::string to_string(const uuid_t& uuid)
+    {
+      std::string result(36, '-');
+      _impl::_format(&result[0], uuid);
+      return result;
+    }
+
+    inline uuid_t from_string(const std::string& uuid)
+    {
+      uint64_t high = 0;
+      uint64_t low = 0;
+      if (36 != uuid.size() || !_impl::_parse(uuid.data(), high, low))
+      {
+        throw std::runtime_error("Uuid parsing error");
+      }
+      uuid_t result;
+      _impl::_store64(result.bytes.data(), high);
+      _impl::_store64(result.bytes.data() + 8, low);
+      return result;
+    }
+
+    inline void format_to(char (&data)[36], const uuid_t& uuid) noexcept
+    {
+      _impl::_format(data, uuid);
+    }
+
+    inline bool parse(const char* data, uuid_t& uuid, version_t version) noexcept
+    {
+      return _impl::_parse(data, uuid, version);
+    }
+
+    inline bool normalize(char* data, uuid_t& uuid, version_t version) noexcept
+    {
+      if (!_impl::_parse(data, uuid, version))
+      {
+        return false;
+      }
+      _impl::_format(data, uuid);
       return true;
     }
+
+    inline std::string to_ulid(const uuid_t& uuid)
+    {
+      std::string result(26, '0');
+      _impl::_format_ulid(&result[0], uuid);
+      return result;
+    }
+
+    inline uuid_t from_ulid(const std::string& ulid)
+    {
+      uuid_t result;
+      if (26 != ulid.size() || !parse_ulid(ulid.data(), result))
+      {
+        throw std::runtime_error("Ulid parsing error");
+      }
+      return result;
+    }
+
+    inline void format_ulid_to(char (&data)[26], const uuid_t& uuid) noexcept
+    {
+      _impl::_format_ulid(data, uuid);
+    }
+
+    inline bool parse_ulid(const char* data, uuid_t& uuid) noexcept
+    {
+      uint64_t high = 0;
+      uint64_t low = 0;
+      if (!_impl::_parse_ulid(data, high, low))
+      {
+        return false;
+      }
+      _impl::_store64(uuid.bytes.data(), high);
+      _impl::_store64(uuid.bytes.data() + 8, low);
+      return true;
+    }
+
+    inline std::chrono::system_clock::time_point extract_time(const uuid_t& uuid) noexcept
+    {
+      return std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(
+        std::chrono::milliseconds(static_cast<int64_t>(_impl::_load64(uuid.bytes.data()) >> 16))));
+    }
   }
+}
+
+namespace std
+{
+  template<>
+  struct hash<flib::uuid_t>
+  {
+    std::size_t operator()(const flib::uuid_t& uuid) const noexcept
+    {
+      // Words are folded and mixed, since time-based versions have low-entropy leading bytes
+      auto value = flib::uuid::_impl::_load64(uuid.bytes.data()) ^ flib::uuid::_impl::_load64(uuid.bytes.data() + 8);
+      value = (value ^ value >> 32) * 0x9e3779b97f4a7c15ull;
+      return static_cast<std::size_t>(value ^ value >> 29);
+    }
+  };
 }
\ No newline at end of file
@@ -0,0 +1,621 @@
+// Copyright © 2024 Luka Arnecic.
+// See the LICENSE file at the top-level directory of this distribution.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include <flib/bit.hpp>
+#include <flib/uuid.hpp>
+
+#if !defined(FLIB_NO_SSE2) & (defined(__SSE2__) | defined(_M_X64))
+#  define FLIB_SSE2
+#  include <emmintrin.h>
+#endif
+
+namespace flib
+{
+#pragma region API
+  // Optional macros:
+  //  - FLIB_NO_SSE2 ... disables use of SSE2 instructions in probing of uuid_set and uuid_map
+  //
+  // SSE2 instructions are used when enabled for compilation (default for x86-64), otherwise groups of slots are probed
+  // with portable 64-bit word operations
+
+  // Common implementation of flat open-addressing hash tables keyed by uuid (Swiss tables)
+  //
+  // Slots (keys stored inline with values) are partitioned into groups, with one control byte per slot (empty, deleted
+  // or 7 bits of key hash), so that lookup matches control bytes of whole group at once and compares keys only on
+  // control byte match. Keys are hashed by folding their halves together with single multiply, so that keys differing
+  // in either half (e.g. client-supplied keys sharing trailing bytes) are spread across groups. Values are expected to
+  // be nothrow movable.
+  template<class Slot>
+  class _uuid_table
+  {
+  public:
+    std::size_t capacity(void) const noexcept;
+    void clear(void) noexcept;
+    bool contains(const uuid_t& p_key) const noexcept;
+    bool empty(void) const noexcept;
+    bool erase(const uuid_t& p_key) noexcept;
+
+    // Method for reserving capacity, so that given number of keys can be inserted without rehashing
+    //
+    // Parameters:
+    //   p_count - Number of keys
+    void reserve(std::size_t p_count);
+    std::size_t size(void) const noexcept;
+
+  protected:
+    _uuid_table(void) = default;
+    _uuid_table(const _uuid_table& p_other);
+    _uuid_table(_uuid_table&& p_other) noexcept;
+    ~_uuid_table(void) noexcept;
+    _uuid_table& operator=(const _uuid_table& p_other);
+    _uuid_table& operator=(_uuid_table&& p_other) noexcept;
+    template<class... Args>
+    std::pair<Slot*, bool> _emplace(const uuid_t& p_key, Args&&... p_args);
+    Slot* _find(const uuid_t& p_key) const noexcept;
+    template<class Function>
+    void _for_each(Function& p_function) const;
+
+  private:
+    std::size_t _free_slot(uint64_t p_hash) const noexcept;
+    static uint64_t _hash(const uuid_t& p_key) noexcept;
+    static std::size_t _max_load(std::size_t p_capacity) noexcept;
+    void _rehash(std::size_t p_capacity);
+    void _release(void) noexcept;
+
+  private:
+    int8_t* m_control{ nullptr };
+    Slot* m_slots{ nullptr };
+    std::size_t m_capacity{ 0 };
+    std::size_t m_size{ 0 };
+    std::size_t m_deleted{ 0 };
+  };
+
+  struct _uuid_set_slot_t
+  {
+    explicit _uuid_set_slot_t(const uuid_t& p_key) noexcept;
+
+    uuid_t key;
+  };
+
+  template<class Value>
+  struct _uuid_map_slot_t
+  {
+    template<class... Args>
+    explicit _uuid_map_slot_t(const uuid_t& p_key, Args&&... p_args);
+
+    uuid_t key;
+    Value value;
+  };
+
+  // Flat hash set of uuids
+  //
+  // Hash is not keyed, so keys from untrusted sources can still be chosen to collide deliberately (degrading lookup to
+  // linear probing), which applies to uuid_map as well
+  class uuid_set
+    : public _uuid_table<_uuid_set_slot_t>
+  {
+  public:
+    uuid_set(void) = default;
+    uuid_set(std::initializer_list<uuid_t> p_keys);
+
+    // Method for iterating over keys in unspecified order
+    //
+    // Parameters:
+    //   p_function - Function called with each key
+    template<class Function>
+    void for_each(Function p_function) const;
+
+    // Method for inserting key
+    //
+    // Parameters:
+    //   p_key - Inserted key
+    //
+    // Returns:
+    //   true if key was inserted, false if it was already present
+    bool insert(const uuid_t& p_key);
+  };
+
+  // Flat hash map keyed by uuids
+  template<class Value>
+  class uuid_map
+    : public _uuid_table<_uuid_map_slot_t<Value>>
+  {
+  public:
+    Value& operator[](const uuid_t& p_key);
+
+    // Method for constructing value in place, unless key is already present
+    //
+    // Parameters:
+    //   p_key  - Key
+    //   p_args - Value constructor arguments
+    //
+    // Returns:
+    //   true if value was inserted, false if key was already present
+    template<class... Args>
+    bool emplace(const uuid_t& p_key, Args&&... p_args);
+
+    // Method for finding value of key
+    //
+    // Parameters:
+    //   p_key - Searched key
+    //
+    // Returns:
+    //   pointer to value (invalidated by insertion) or nullptr if key is not present
+    Value* find(const uuid_t& p_key) noexcept;
+    const Value* find(const uuid_t& p_key) const noexcept;
+
+    // Method for iterating over key-value pairs in unspecified order
+    //
+    // Parameters:
+    //   p_function - Function called with each key and its value
+    template<class Function>
+    void for_each(Function p_function);
+    template<class Function>
+    void for_each(Function p_function) const;
+  };
+#pragma endregion
+
+#pragma region IMPLEMENTATION
+  constexpr int8_t _uuid_empty = -128;
+  constexpr int8_t _uuid_deleted = -2;
+
+  // Group of control bytes, matched as bit masks with bits of slot at position (slot << _uuid_group_shift)
+#if defined(FLIB_SSE2)
+  constexpr std::size_t _uuid_group_size = 16;
+  constexpr int _uuid_group_shift = 0;
+
+  class _uuid_group_t
+  {
+  public:
+    explicit _uuid_group_t(const int8_t* p_control) noexcept
+      : m_control(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p_control)))
+    {
+    }
+
+    uint64_t match(int8_t p_hash) const noexcept
+    {
+      return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(m_control, _mm_set1_epi8(p_hash))));
+    }
+
+    uint64_t match_empty(void) const noexcept
+    {
+      return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(m_control, _mm_set1_epi8(_uuid_empty))));
+    }
+
+    // Empty or deleted slots
+    uint64_t match_free(void) const noexcept
+    {
+      return static_cast<uint32_t>(_mm_movemask_epi8(m_control));
+    }
+
+  private:
+    __m128i m_control;
+  };
+#else
+  constexpr std::size_t _uuid_group_size = 8;
+  constexpr int _uuid_group_shift = 3;
+
+  class _uuid_group_t
+  {
+  public:
+    explicit _uuid_group_t(const int8_t* p_control) noexcept
+      : m_control(0)
+    {
+      for (auto i = 0; i < 8; ++i)
+      {
+        m_control |= static_cast<uint64_t>(static_cast<uint8_t>(p_control[i])) << 8 * i;
+      }
+    }
+
+    // May report false positives (only above actual match), which are rejected by key comparison
+    uint64_t match(int8_t p_hash) const noexcept
+    {
+      auto bytes = m_control ^ (s_low_bits * static_cast<uint8_t>(p_hash));
+      return (bytes - s_low_bits) & ~bytes & s_high_bits;
+    }
+
+    // Empty slots are the only ones with high bit set and second lowest bit cleared
+    uint64_t match_empty(void) const noexcept
+    {
+      return m_control & ~(m_control << 6) & s_high_bits;
+    }
+
+    // Empty or deleted slots
+    uint64_t match_free(void) const noexcept
+    {
+      return m_control & s_high_bits;
+    }
+
+  private:
+    static constexpr uint64_t s_low_bits = 0x0101010101010101ull;
+    static constexpr uint64_t s_high_bits = 0x8080808080808080ull;
+
+  private:
+    uint64_t m_control;
+  };
+#endif
+
+  template<class Slot>
+  inline _uuid_table<Slot>::_uuid_table(const _uuid_table& p_other)
+  {
+    if (0 == p_other.m_capacity)
+    {
+      return;
+    }
+    m_control = new int8_t[p_other.m_capacity];
+    m_slots = std::allocator<Slot>().allocate(p_other.m_capacity);
+    m_capacity = p_other.m_capacity;
+    std::memset(m_control, _uuid_empty, m_capacity);
+    try
+    {
+      // Slots are copied to same positions, while deleted markers are kept to preserve probe sequences
+      for (std::size_t i = 0; i < m_capacity; ++i)
+      {
+        if (0 <= p_other.m_control[i])
+        {
+          ::new (static_cast<void*>(m_slots + i)) Slot(p_other.m_slots[i]);
+          ++m_size;
+        }
+        m_control[i] = p_other.m_control[i];
+      }
+    }
+    catch (...)
+    {
+      _release();
+      throw;
+    }
+    m_deleted = p_other.m_deleted;
+  }
+
+  template<class Slot>
+  inline _uuid_table<Slot>::_uuid_table(_uuid_table&& p_other) noexcept
+    : m_control(p_other.m_control),
+    m_slots(p_other.m_slots),
+    m_capacity(p_other.m_capacity),
+    m_size(p_other.m_size),
+    m_deleted(p_other.m_deleted)
+  {
+    p_other.m_control = nullptr;
+    p_other.m_slots = nullptr;
+    p_other.m_capacity = 0;
+    p_other.m_size = 0;
+    p_other.m_deleted = 0;
+  }
+
+  template<class Slot>
+  inline _uuid_table<Slot>::~_uuid_table(void) noexcept
+  {
+    _release();
+  }
+
+  template<class Slot>
+  inline _uuid_table<Slot>& _uuid_table<Slot>::operator=(const _uuid_table& p_other)
+  {
+    if (this != &p_other)
+    {
+      *this = _uuid_table(p_other);
+    }
+    return *this;
+  }
+
+  template<class Slot>
+  inline _uuid_table<Slot>& _uuid_table<Slot>::operator=(_uuid_table&& p_other) noexcept
+  {
+    std::swap(m_control, p_other.m_control);
+    std::swap(m_slots, p_other.m_slots);
+    std::swap(m_capacity, p_other.m_capacity);
+    std::swap(m_size, p_other.m_size);
+    std::swap(m_deleted, p_other.m_deleted);
+    return *this;
+  }
+
+  template<class Slot>
+  inline std::size_t _uuid_table<Slot>::capacity(void) const noexcept
+  {
+    return m_capacity;
+  }
+
+  template<class Slot>
+  inline void _uuid_table<Slot>::clear(void) noexcept
+  {
+    for (std::size_t i = 0; i < m_capacity; ++i)
+    {
+      if (0 <= m_control[i])
+      {
+        m_slots[i].~Slot();
+      }
+    }
+    if (0 != m_capacity)
+    {
+      std::memset(m_control, _uuid_empty, m_capacity);
+    }
+    m_size = 0;
+    m_deleted = 0;
+  }
+
+  template<class Slot>
+  inline bool _uuid_table<Slot>::contains(const uuid_t& p_key) const noexcept
+  {
+    return nullptr != _find(p_key);
+  }
+
+  template<class Slot>
+  inline bool _uuid_table<Slot>::empty(void) const noexcept
+  {
+    return 0 == m_size;
+  }
+
+  template<class Slot>
+  inline bool _uuid_table<Slot>::erase(const uuid_t& p_key) noexcept
+  {
+    auto slot = _find(p_key);
+    if (nullptr == slot)
+    {
+      return false;
+    }
+    auto index = static_cast<std::size_t>(slot - m_slots);
+    slot->~Slot();
+    --m_size;
+    // Probing stops at group with empty slot, so slot can be emptied instead of deleted if its group has one
+    if (0 != _uuid_group_t(m_control + index / _uuid_group_size * _uuid_group_size).match_empty())
+    {
+      m_control[index] = _uuid_empty;
+    }
+    else
+    {
+      m_control[index] = _uuid_deleted;
+      ++m_deleted;
+    }
+    return true;
+  }
+
+  template<class Slot>
+  inline void _uuid_table<Slot>::reserve(std::size_t p_count)
+  {
+    auto capacity = _uuid_group_size;
+    while (_max_load(capacity) < p_count)
+    {
+      capacity *= 2;
+    }
+    if (capacity > m_capacity)
+    {
+      _rehash(capacity);
+    }
+  }
+
+  template<class Slot>
+  inline std::size_t _uuid_table<Slot>::size(void) const noexcept
+  {
+    return m_size;
+  }
+
+  template<class Slot>
+  template<class... Args>
+  inline std::pair<Slot*, bool> _uuid_table<Slot>::_emplace(const uuid_t& p_key, Args&&... p_args)
+  {
+    auto slot = _find(p_key);
+    if (nullptr != slot)
+    {
+      return { slot, false };
+    }
+    if (m_size + m_deleted >= _max_load(m_capacity))
+    {
+      // Table grows if it is at least half full, otherwise deleted slots are reclaimed
+      _rehash(2 * m_size >= _max_load(m_capacity) ? (0 == m_capacity ? _uuid_group_size : 2 * m_capacity) :
+        m_capacity);
+    }
+    auto hash = _hash(p_key);
+    auto index = _free_slot(hash);
+    slot = ::new (static_cast<void*>(m_slots + index)) Slot(p_key, std::forward<Args>(p_args)...);
+    m_deleted -= _uuid_deleted == m_control[index] ? 1 : 0;
+    m_control[index] = static_cast<int8_t>(hash & 0x7f);
+    ++m_size;
+    return { slot, true };
+  }
+
+  template<class Slot>
+  inline Slot* _uuid_table<Slot>::_find(const uuid_t& p_key) const noexcept
+  {
+    if (0 == m_capacity)
+    {
+      return nullptr;
+    }
+    auto hash = _hash(p_key);
+    auto control = static_cast<int8_t>(hash & 0x7f);
+    auto mask = m_capacity / _uuid_group_size - 1;
+    auto group = static_cast<std::size_t>(hash >> 7) & mask;
+    for (std::size_t step = 1;; group = (group + step++) & mask)
+    {
+      _uuid_group_t matcher(m_control + group * _uuid_group_size);
+      for (auto match = matcher.match(control); 0 != match; match &= match - 1)
+      {
+        auto index = group * _uuid_group_size + (countr_zero(match) >> _uuid_group_shift);
+        if (m_slots[index].key == p_key)
+        {
+          return m_slots + index;
+        }
+      }
+      if (0 != matcher.match_empty())
+      {
+        return nullptr;
+      }
+    }
+  }
+
+  template<class Slot>
+  template<class Function>
+  inline void _uuid_table<Slot>::_for_each(Function& p_function) const
+  {
+    for (std::size_t i = 0; i < m_capacity; ++i)
+    {
+      if (0 <= m_control[i])
+      {
+        p_function(m_slots[i]);
+      }
+    }
+  }
+
+  // Triangular probing over power of two number of groups visits every group
+  template<class Slot>
+  inline std::size_t _uuid_table<Slot>::_free_slot(uint64_t p_hash) const noexcept
+  {
+    auto mask = m_capacity / _uuid_group_size - 1;
+    auto group = static_cast<std::size_t>(p_hash >> 7) & mask;
+    for (std::size_t step = 1;; group = (group + step++) & mask)
+    {
+      auto match = _uuid_group_t(m_control + group * _uuid_group_size).match_free();
+      if (0 != match)
+      {
+        return group * _uuid_group_size + (countr_zero(match) >> _uuid_group_shift);
+      }
+    }
+  }
+
+  template<class Slot>
+  inline uint64_t _uuid_table<Slot>::_hash(const uuid_t& p_key) noexcept
+  {
+    // Upper half of product is folded into lower bits, which select group and control byte
+    auto hash = (uuid::_impl::_load64(p_key.bytes.data()) ^ uuid::_impl::_load64(p_key.bytes.data() + 8)) *
+      0x9e3779b97f4a7c15ull;
+    return hash ^ hash >> 32;
+  }
+
+  // Maximum load factor of 7/8
+  template<class Slot>
+  inline std::size_t _uuid_table<Slot>::_max_load(std::size_t p_capacity) noexcept
+  {
+    return p_capacity - p_capacity / 8;
+  }
+
+  template<class Slot>
+  inline void _uuid_table<Slot>::_rehash(std::size_t p_capacity)
+  {
+    _uuid_table table;
+    table.m_control = new int8_t[p_capacity];
+    table.m_slots = std::allocator<Slot>().allocate(p_capacity);
+    table.m_capacity = p_capacity;
+    std::memset(table.m_control, _uuid_empty, p_capacity);
+    for (std::size_t i = 0; i < m_capacity; ++i)
+    {
+      if (0 <= m_control[i])
+      {
+        auto index = table._free_slot(_hash(m_slots[i].key));
+        ::new (static_cast<void*>(table.m_slots + index)) Slot(std::move(m_slots[i]));
+        table.m_control[index] = m_control[i];
+        ++table.m_size;
+      }
+    }
+    *this = std::move(table);
+  }
+
+  template<class Slot>
+  inline void _uuid_table<Slot>::_release(void) noexcept
+  {
+    clear();
+    if (0 != m_capacity)
+    {
+      delete[] m_control;
+      std::allocator<Slot>().deallocate(m_slots, m_capacity);
+    }
+    m_control = nullptr;
+    m_slots = nullptr;
+    m_capacity = 0;
+  }
+
+  inline _uuid_set_slot_t::_uuid_set_slot_t(const uuid_t& p_key) noexcept
+    : key(p_key)
+  {
+  }
+
+  template<class Value>
+  template<class... Args>
+  inline _uuid_map_slot_t<Value>::_uuid_map_slot_t(const uuid_t& p_key, Args&&... p_args)
+    : key(p_key),
+    value(std::forward<Args>(p_args)...)
+  {
+  }
+
+  inline uuid_set::uuid_set(std::initializer_list<uuid_t> p_keys)
+  {
+    reserve(p_keys.size());
+    for (auto& key : p_keys)
+    {
+      insert(key);
+    }
+  }
+
+  template<class Function>
+  inline void uuid_set::for_each(Function p_function) const
+  {
+    auto function = [&p_function](const _uuid_set_slot_t& p_slot)
+      {
+        p_function(p_slot.key);
+      };
+    _for_each(function);
+  }
+
+  inline bool uuid_set::insert(const uuid_t& p_key)
+  {
+    return _emplace(p_key).second;
+  }
+
+  template<class Value>
+  inline Value& uuid_map<Value>::operator[](const uuid_t& p_key)
+  {
+    return this->_emplace(p_key).first->value;
+  }
+
+  template<class Value>
+  template<class... Args>
+  inline bool uuid_map<Value>::emplace(const uuid_t& p_key, Args&&... p_args)
+  {
+    return this->_emplace(p_key, std::forward<Args>(p_args)...).second;
+  }
+
+  template<class Value>
+  inline Value* uuid_map<Value>::find(const uuid_t& p_key) noexcept
+  {
+    auto slot = this->_find(p_key);
+    return nullptr == slot ? nullptr : &slot->value;
+  }
+
+  template<class Value>
+  inline const Value* uuid_map<Value>::find(const uuid_t& p_key) const noexcept
+  {
+    auto slot = this->_find(p_key);
+    return nullptr == slot ? nullptr : &slot->value;
+  }
+
+  template<class Value>
+  template<class Function>
+  inline void uuid_map<Value>::for_each(Function p_function)
+  {
+    auto function = [&p_function](_uuid_map_slot_t<Value>& p_slot)
+      {
+        p_function(static_cast<const uuid_t&>(p_slot.key), p_slot.value);
+      };
+    this->_for_each(function);
+  }
+
+  template<class Value>
+  template<class Function>
+  inline void uuid_map<Value>::for_each(Function p_function) const
+  {
+    auto function = [&p_function](const _uuid_map_slot_t<Value>& p_slot)
+      {
+        p_function(p_slot.key, static_cast<const Value&>(p_slot.value));
+      };
+    this->_for_each(function);
+  }
+#pragma endregion
+}
\ No newline at end of file
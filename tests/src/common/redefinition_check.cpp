@@ -3,12 +3,18 @@
 
 // safeguard against redefinition link issue in case of multiple header inclusion within single compilation unit
 #include <flib/atomic.hpp>
+#include <flib/atomic_flags.hpp>
 #include <flib/bit.hpp>
+#include <flib/clock.hpp>
 #include <flib/dll.hpp>
+#include <flib/log_index.hpp>
 #include <flib/observable.hpp>
 #include <flib/pimpl.hpp>
+#include <flib/random.hpp>
+#include <flib/roaring.hpp>
 #include <flib/timer.hpp>
 #include <flib/timestamp.hpp>
 #include <flib/uuid.hpp>
+#include <flib/uuid_map.hpp>
 #include <flib/version.hpp>
 #include <flib/worker.hpp>
\ No newline at end of file
@@ -0,0 +1,223 @@
+// Copyright © 2024 Luka Arnecic.
+// See the LICENSE file at the top-level directory of this distribution.
+
+#include <flib/atomic_flags.hpp>
+
+#include <flib/atomic.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch2.hpp>
+
+namespace
+{
+  enum class test_flags
+    : uint8_t
+  {
+    none       = 0b00000000,
+    option_1   = 0b00000001,
+    option_2   = 0b00000010,
+    option_3   = 0b00000100,
+    option_4   = 0b00001000,
+    option_12  = 0b00000011,
+    option_123 = 0b00000111
+  };
+
+  enum class wide_flags
+    : uint64_t
+  {
+    none = 0,
+    low  = 1ull,
+    high = 1ull << 63
+  };
+}
+
+TEST_CASE("Atomic flags tests - Sanity check", "[atomic_flags]")
+{
+  using namespace flib;
+  SECTION("Modification")
+  {
+    flib::atomic_flags<::test_flags> flags;
+    REQUIRE(::test_flags::none == flags.load());
+    REQUIRE(::test_flags::none == flags.set(::test_flags::option_12));
+    REQUIRE(::test_flags::option_12 == flags);
+    REQUIRE(flags.test(::test_flags::option_1));
+    REQUIRE(flags.test(::test_flags::option_12));
+    REQUIRE(!flags.test(::test_flags::option_123));
+    REQUIRE(::test_flags::option_12 == flags.clear(::test_flags::option_1));
+    REQUIRE(::test_flags::option_2 == flags.load());
+    REQUIRE(::test_flags::option_2 == flags.toggle(::test_flags::option_12));
+    REQUIRE(::test_flags::option_1 == flags.load());
+    REQUIRE(::test_flags::option_1 == flags.store(::test_flags::option_4));
+    REQUIRE(::test_flags::option_4 == flags.load());
+  }
+  SECTION("Test and set")
+  {
+    flib::atomic_flags<::test_flags> flags(::test_flags::option_1);
+    REQUIRE(flags.test_and_set(::test_flags::option_1));
+    REQUIRE(!flags.test_and_set(::test_flags::option_12));
+    REQUIRE(flags.test_and_set(::test_flags::option_12));
+    REQUIRE(::test_flags::option_12 == flags.load());
+  }
+  SECTION("Wide underlying type")
+  {
+    flib::atomic_flags<::wide_flags> flags(::wide_flags::high);
+    REQUIRE(!flags.test_and_set(::wide_flags::low));
+    REQUIRE(flags.test(::wide_flags::low | ::wide_flags::high));
+    flags.clear(::wide_flags::high);
+    REQUIRE(::wide_flags::low == flags.load());
+  }
+}
+
+TEST_CASE("Atomic flags tests - Concurrent modification", "[atomic_flags]")
+{
+  using namespace flib;
+  SECTION("Claiming")
+  {
+    flib::atomic_flags<::test_flags> flags;
+    std::atomic<int> claims{ 0 };
+    std::vector<std::thread> threads;
+    for (auto i = 0; i < 4; ++i)
+    {
+      threads.emplace_back([&flags, &claims]()
+        {
+          for (auto flag : { ::test_flags::option_1, ::test_flags::option_2, ::test_flags::option_3 })
+          {
+            claims += flags.test_and_set(flag) ? 0 : 1;
+          }
+        });
+    }
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
+    REQUIRE(3 == claims);
+    REQUIRE(::test_flags::option_123 == flags.load());
+  }
+  SECTION("Toggling")
+  {
+    flib::atomic_flags<::test_flags> flags(::test_flags::option_4);
+    std::vector<std::thread> threads;
+    for (auto flag : { ::test_flags::option_1, ::test_flags::option_2, ::test_flags::option_3 })
+    {
+      threads.emplace_back([&flags, flag]()
+        {
+          for (auto i = 0; i < 100000; ++i)
+          {
+            flags.toggle(flag);
+          }
+        });
+    }
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
+    REQUIRE(::test_flags::option_4 == flags.load());
+  }
+}
+
+TEST_CASE("Atomic flags tests - Waiting", "[atomic_flags]")
+{
+  using namespace flib;
+  SECTION("Satisfied wait")
+  {
+    flib::atomic_flags<::test_flags> flags(::test_flags::option_12);
+    REQUIRE(::test_flags::option_12 == flags.wait_all(::test_flags::option_12));
+    REQUIRE(::test_flags::option_12 == flags.wait_any(::test_flags::option_123));
+  }
+  SECTION("Wait for any")
+  {
+    flib::atomic_flags<::test_flags> flags;
+    auto task = std::async(std::launch::async, [&flags]()
+      {
+        return flags.wait_any(::test_flags::option_12);
+      });
+    REQUIRE(std::future_status::timeout == task.wait_for(std::chrono::milliseconds(50)));
+    flags.set(::test_flags::option_3);
+    REQUIRE(std::future_status::timeout == task.wait_for(std::chrono::milliseconds(50)));
+    flags.set(::test_flags::option_2);
+    REQUIRE(std::future_status::ready == task.wait_for(std::chrono::seconds(5)));
+    REQUIRE(flib::is_flag_set(task.get(), ::test_flags::option_2));
+  }
+  SECTION("Wait for all")
+  {
+    flib::atomic_flags<::test_flags> flags;
+    std::vector<std::future<::test_flags>> tasks;
+    for (auto i = 0; i < 4; ++i)
+    {
+      tasks.push_back(std::async(std::launch::async, [&flags]()
+        {
+          return flags.wait_all(::test_flags::option_123);
+        }));
+    }
+    flags.set(::test_flags::option_1);
+    flags.toggle(::test_flags::option_2);
+    REQUIRE(std::future_status::timeout == tasks[0].wait_for(std::chrono::milliseconds(50)));
+    flags.store(::test_flags::option_123);
+    for (auto& task : tasks)
+    {
+      REQUIRE(std::future_status::ready == task.wait_for(std::chrono::seconds(5)));
+      REQUIRE(::test_flags::option_123 == task.get());
+    }
+  }
+  SECTION("Handoff")
+  {
+    // Threads alternate by waiting for flag set by other thread, so that every lost wakeup would block
+    flib::atomic_flags<::test_flags> flags;
+    auto task = std::async(std::launch::async, [&flags]()
+      {
+        for (auto i = 0; i < 10000; ++i)
+        {
+          flags.wait_any(::test_flags::option_1);
+          flags.clear(::test_flags::option_1);
+          flags.set(::test_flags::option_2);
+        }
+      });
+    for (auto i = 0; i < 10000; ++i)
+    {
+      flags.set(::test_flags::option_1);
+      flags.wait_any(::test_flags::option_2);
+      flags.clear(::test_flags::option_2);
+    }
+    REQUIRE(std::future_status::ready == task.wait_for(std::chrono::seconds(5)));
+  }
+}
+
+TEST_CASE("Atomic flags tests - Benchmarks", "[atomic_flags][.benchmark]")
+{
+  using namespace flib;
+  flib::atomic<::test_flags> locked_flags(::test_flags::none);
+  flib::atomic_flags<::test_flags> flags;
+  BENCHMARK("flib::atomic set and clear x1000")
+  {
+    for (auto i = 1000; i > 0; --i)
+    {
+      locked_flags.store(locked_flags.load() | ::test_flags::option_1);
+      locked_flags.store(locked_flags.load() & ~::test_flags::option_1);
+    }
+    return locked_flags.load();
+  };
+  BENCHMARK("flib::atomic_flags set and clear x1000")
+  {
+    for (auto i = 1000; i > 0; --i)
+    {
+      flags.set(::test_flags::option_1);
+      flags.clear(::test_flags::option_1);
+    }
+    return flags.load();
+  };
+  BENCHMARK("flib::atomic_flags test x1000")
+  {
+    auto result = 0;
+    for (auto i = 1000; i > 0; --i)
+    {
+      result += flags.test(::test_flags::option_1) ? 1 : 0;
+    }
+    return result;
+  };
+}
\ No newline at end of file
@@ -5,9 +5,34 @@
 
 #include <cstddef>
 #include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
 
 #include <catch2/catch2.hpp>
 
+namespace
+{
+  uint32_t next_random(std::mt19937& p_generator)
+  {
+    return static_cast<uint32_t>(p_generator());
+  }
+
+  template<class T>
+  T interleave(const uint32_t* p_coordinates, uint8_t p_dimensions, uint8_t p_bits)
+  {
+    T result = 0;
+    for (uint8_t bit = 0; bit < p_bits; ++bit)
+    {
+      for (uint8_t dimension = 0; dimension < p_dimensions; ++dimension)
+      {
+        result |= static_cast<T>(static_cast<T>(p_coordinates[dimension] >> bit & 1u) << (bit * p_dimensions + dimension));
+      }
+    }
+    return result;
+  }
+}
+
 TEST_CASE("Bit tests - Endianess", "[bit]")
 {
   REQUIRE((flib::endian::native() == flib::endian::big_byte ||
@@ -46,4 +71,142 @@ TEST_CASE("Bit tests - Byte swapping", "[bit]")
     flib::byteswap(bytes, bytes + sizeof(bytes));
     REQUIRE(std::equal(std::cbegin(bytes), std::cend(bytes), std::cbegin(reversed)));
   }
+}
+
+TEST_CASE("Bit tests - Bit counting", "[bit]")
+{
+  SECTION("Population count")
+  {
+    REQUIRE(0 == flib::popcount(0x0000000000000000ull));
+    REQUIRE(1 == flib::popcount(0x8000000000000000ull));
+    REQUIRE(32 == flib::popcount(0x5555555555555555ull));
+    REQUIRE(64 == flib::popcount(0xffffffffffffffffull));
+  }
+  SECTION("Trailing zero count")
+  {
+    REQUIRE(64 == flib::countr_zero(0x0000000000000000ull));
+    REQUIRE(0 == flib::countr_zero(0x0000000000000001ull));
+    REQUIRE(4 == flib::countr_zero(0x00000000000000f0ull));
+    REQUIRE(63 == flib::countr_zero(0x8000000000000000ull));
+  }
+}
+
+TEST_CASE("Bit tests - Morton codes", "[bit]")
+{
+  std::mt19937 generator(42);
+  SECTION("2D 32-bit")
+  {
+    REQUIRE(0x00000000ul == flib::morton2d_encode32(0x0000u, 0x0000u));
+    REQUIRE(0x55555555ul == flib::morton2d_encode32(0xffffu, 0x0000u));
+    REQUIRE(0xaaaaaaaaul == flib::morton2d_encode32(0x0000u, 0xffffu));
+    REQUIRE(0x0000000bul == flib::morton2d_encode32(0x0001u, 0x0003u));
+    for (auto i = 1000; i > 0; --i)
+    {
+      const uint32_t coordinates[] = { ::next_random(generator) & 0xffffu, ::next_random(generator) & 0xffffu };
+      const auto code = flib::morton2d_encode32(static_cast<uint16_t>(coordinates[0]), static_cast<uint16_t>(coordinates[1]));
+      REQUIRE(::interleave<uint32_t>(coordinates, 2, 16) == code);
+      uint16_t x, y;
+      flib::morton2d_decode32(code, x, y);
+      REQUIRE(coordinates[0] == x);
+      REQUIRE(coordinates[1] == y);
+    }
+  }
+  SECTION("2D 64-bit")
+  {
+    REQUIRE(0x5555555555555555ull == flib::morton2d_encode64(0xfffffffful, 0x00000000ul));
+    REQUIRE(0xaaaaaaaaaaaaaaaaull == flib::morton2d_encode64(0x00000000ul, 0xfffffffful));
+    for (auto i = 1000; i > 0; --i)
+    {
+      const uint32_t coordinates[] = { ::next_random(generator), ::next_random(generator) };
+      const auto code = flib::morton2d_encode64(coordinates[0], coordinates[1]);
+      REQUIRE(::interleave<uint64_t>(coordinates, 2, 32) == code);
+      uint32_t x, y;
+      flib::morton2d_decode64(code, x, y);
+      REQUIRE(coordinates[0] == x);
+      REQUIRE(coordinates[1] == y);
+    }
+  }
+  SECTION("3D 32-bit")
+  {
+    REQUIRE(0x09249249ul == flib::morton3d_encode32(0x03ffu, 0x0000u, 0x0000u));
+    REQUIRE(0x3ffffffful == flib::morton3d_encode32(0xffffu, 0xffffu, 0xffffu));
+    for (auto i = 1000; i > 0; --i)
+    {
+      const uint32_t coordinates[] = { ::next_random(generator) & 0x3ffu, ::next_random(generator) & 0x3ffu, ::next_random(generator) & 0x3ffu };
+      const auto code = flib::morton3d_encode32(static_cast<uint16_t>(coordinates[0]),
+        static_cast<uint16_t>(coordinates[1]), static_cast<uint16_t>(coordinates[2]));
+      REQUIRE(::interleave<uint32_t>(coordinates, 3, 10) == code);
+      uint16_t x, y, z;
+      flib::morton3d_decode32(code, x, y, z);
+      REQUIRE(coordinates[0] == x);
+      REQUIRE(coordinates[1] == y);
+      REQUIRE(coordinates[2] == z);
+    }
+  }
+  SECTION("3D 64-bit")
+  {
+    REQUIRE(0x1249249249249249ull == flib::morton3d_encode64(0x001ffffful, 0x00000000ul, 0x00000000ul));
+    REQUIRE(0x7fffffffffffffffull == flib::morton3d_encode64(0xfffffffful, 0xfffffffful, 0xfffffffful));
+    for (auto i = 1000; i > 0; --i)
+    {
+      const uint32_t coordinates[] = { ::next_random(generator) & 0x1fffffu, ::next_random(generator) & 0x1fffffu, ::next_random(generator) & 0x1fffffu };
+      const auto code = flib::morton3d_encode64(coordinates[0], coordinates[1], coordinates[2]);
+      REQUIRE(::interleave<uint64_t>(coordinates, 3, 21) == code);
+      uint32_t x, y, z;
+      flib::morton3d_decode64(code, x, y, z);
+      REQUIRE(coordinates[0] == x);
+      REQUIRE(coordinates[1] == y);
+      REQUIRE(coordinates[2] == z);
+    }
+  }
+  SECTION("Bulk conversions")
+  {
+    std::vector<uint16_t> x(1000), y(1000), z(1000), dx(1000), dy(1000), dz(1000);
+    std::vector<uint32_t> codes(1000);
+    for (std::size_t i = 0; i < x.size(); ++i)
+    {
+      x[i] = static_cast<uint16_t>(::next_random(generator) & 0x3ffu);
+      y[i] = static_cast<uint16_t>(::next_random(generator) & 0x3ffu);
+      z[i] = static_cast<uint16_t>(::next_random(generator) & 0x3ffu);
+    }
+    flib::morton2d_encode32(x.data(), x.data() + x.size(), y.data(), codes.data());
+    REQUIRE(flib::morton2d_encode32(x[500], y[500]) == codes[500]);
+    flib::morton2d_decode32(codes.data(), codes.data() + codes.size(), dx.data(), dy.data());
+    REQUIRE(x == dx);
+    REQUIRE(y == dy);
+    flib::morton3d_encode32(x.data(), x.data() + x.size(), y.data(), z.data(), codes.data());
+    REQUIRE(flib::morton3d_encode32(x[500], y[500], z[500]) == codes[500]);
+    flib::morton3d_decode32(codes.data(), codes.data() + codes.size(), dx.data(), dy.data(), dz.data());
+    REQUIRE(x == dx);
+    REQUIRE(y == dy);
+    REQUIRE(z == dz);
+  }
+}
+
+TEST_CASE("Bit tests - Morton code benchmarks", "[bit][.benchmark]")
+{
+  std::mt19937 generator(42);
+  std::vector<uint32_t> x(4096), y(4096), z(4096);
+  std::vector<uint64_t> codes(4096);
+  for (std::size_t i = 0; i < x.size(); ++i)
+  {
+    x[i] = ::next_random(generator) & 0x1fffffu;
+    y[i] = ::next_random(generator) & 0x1fffffu;
+    z[i] = ::next_random(generator) & 0x1fffffu;
+  }
+  BENCHMARK("2D 64-bit encode (4096 points)")
+  {
+    flib::morton2d_encode64(x.data(), x.data() + x.size(), y.data(), codes.data());
+    return codes.back();
+  };
+  BENCHMARK("3D 64-bit encode (4096 points)")
+  {
+    flib::morton3d_encode64(x.data(), x.data() + x.size(), y.data(), z.data(), codes.data());
+    return codes.back();
+  };
+  BENCHMARK("3D 64-bit decode (4096 points)")
+  {
+    flib::morton3d_decode64(codes.data(), codes.data() + codes.size(), x.data(), y.data(), z.data());
+    return x.back();
+  };
 }
\ No newline at end of file
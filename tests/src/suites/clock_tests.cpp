@@ -0,0 +1,169 @@
+// Copyright © 2024 Luka Arnecic.
+// See the LICENSE file at the top-level directory of this distribution.
+
+#include <flib/clock.hpp>
+#include <flib/timer.hpp>
+#include <flib/timestamp.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <sstream>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <catch2/catch2.hpp>
+
+namespace
+{
+  using milliseconds = std::chrono::duration<int64_t, std::milli>;
+
+  template<class Clock, class ReferenceClock>
+  int64_t max_difference(std::size_t samples)
+  {
+    int64_t result = 0;
+    for (; samples > 0; --samples)
+    {
+      auto reference = ReferenceClock::now();
+      auto difference = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - reference).count();
+      difference = difference < 0 ? -difference : difference;
+      result = difference > result ? difference : result;
+    }
+    return result;
+  }
+
+  template<class Clock>
+  bool monotonic(std::size_t samples)
+  {
+    auto previous = Clock::now();
+    for (; samples > 0; --samples)
+    {
+      auto current = Clock::now();
+      if (current < previous)
+      {
+        return false;
+      }
+      previous = current;
+    }
+    return true;
+  }
+}
+
+TEST_CASE("Clock tests - Clock requirements", "[clock]")
+{
+  static_assert(std::is_same<std::chrono::system_clock::time_point, flib::coarse_system_clock::time_point>::value,
+    "Coarse system clock time point mismatch");
+  static_assert(std::is_same<std::chrono::steady_clock::time_point, flib::coarse_steady_clock::time_point>::value,
+    "Coarse steady clock time point mismatch");
+  static_assert(std::is_same<std::chrono::system_clock::time_point, flib::tsc_system_clock::time_point>::value,
+    "TSC system clock time point mismatch");
+  static_assert(std::is_same<std::chrono::steady_clock::time_point, flib::tsc_steady_clock::time_point>::value,
+    "TSC steady clock time point mismatch");
+  static_assert(!flib::coarse_system_clock::is_steady && flib::coarse_steady_clock::is_steady, "Steadiness mismatch");
+  static_assert(!flib::tsc_system_clock::is_steady && flib::tsc_steady_clock::is_steady, "Steadiness mismatch");
+  SECTION("Coarse clocks")
+  {
+    REQUIRE(::max_difference<flib::coarse_system_clock, std::chrono::system_clock>(1000) < 20000000);
+    REQUIRE(::max_difference<flib::coarse_steady_clock, std::chrono::steady_clock>(1000) < 20000000);
+    REQUIRE(::monotonic<flib::coarse_steady_clock>(100000));
+  }
+  SECTION("TSC clocks")
+  {
+    REQUIRE(::max_difference<flib::tsc_system_clock, std::chrono::system_clock>(1000) < 5000000);
+    REQUIRE(::max_difference<flib::tsc_steady_clock, std::chrono::steady_clock>(1000) < 5000000);
+    REQUIRE(::monotonic<flib::tsc_steady_clock>(100000));
+  }
+  SECTION("TSC clock concurrent readers")
+  {
+    // Readers race with resynchronization performed by other readers
+    std::atomic<int> failures{ 0 };
+    std::vector<std::thread> threads;
+    for (auto i = 0; i < 4; ++i)
+    {
+      threads.emplace_back([&failures]()
+        {
+          failures += ::monotonic<flib::tsc_steady_clock>(2000000) ? 0 : 1;
+        });
+    }
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
+    REQUIRE(0 == failures);
+  }
+}
+
+TEST_CASE("Clock tests - Usage", "[clock]")
+{
+  SECTION("Timestamp generation")
+  {
+    REQUIRE(flib::parse(flib::generate(flib::coarse_system_clock::now())) <= std::chrono::system_clock::now());
+    REQUIRE(flib::parse(flib::generate(flib::tsc_system_clock::now())) <= std::chrono::system_clock::now() +
+      std::chrono::milliseconds(5));
+  }
+  SECTION("Timer")
+  {
+    flib::basic_timer<flib::coarse_steady_clock> coarse_timer;
+    flib::basic_timer<flib::tsc_steady_clock> tsc_timer;
+    std::atomic<uint32_t> reference(0);
+    auto event = [&reference]
+      {
+        ++reference;
+      };
+    coarse_timer.schedule(event, ::milliseconds(10));
+    tsc_timer.schedule(event, ::milliseconds(10));
+    std::this_thread::sleep_for(::milliseconds(100));
+    REQUIRE(!coarse_timer.scheduled());
+    REQUIRE(!tsc_timer.scheduled());
+    REQUIRE(2 == reference);
+  }
+}
+
+TEST_CASE("Clock tests - Benchmarks", "[clock][.benchmark]")
+{
+  BENCHMARK("std::chrono::system_clock::now")
+  {
+    return std::chrono::system_clock::now();
+  };
+  BENCHMARK("std::chrono::steady_clock::now")
+  {
+    return std::chrono::steady_clock::now();
+  };
+  BENCHMARK("flib::coarse_system_clock::now")
+  {
+    return flib::coarse_system_clock::now();
+  };
+  BENCHMARK("flib::coarse_steady_clock::now")
+  {
+    return flib::coarse_steady_clock::now();
+  };
+  BENCHMARK("flib::tsc_system_clock::now")
+  {
+    return flib::tsc_system_clock::now();
+  };
+  BENCHMARK("flib::tsc_steady_clock::now")
+  {
+    return flib::tsc_steady_clock::now();
+  };
+  BENCHMARK("flib::generate (tsc_system_clock)")
+  {
+    return flib::generate(flib::tsc_system_clock::now());
+  };
+}
+
+TEST_CASE("Clock tests - Accuracy report", "[clock][.benchmark]")
+{
+  std::ostringstream report;
+  report << "Maximum difference from reference clock (TSC supported: " << flib::tsc_steady_clock::supported() << ")\n";
+  for (auto round = 0; round < 5; ++round)
+  {
+    report << "  after " << round * 250 << " ms:"
+      << " coarse_system_clock " << ::max_difference<flib::coarse_system_clock, std::chrono::system_clock>(10000) << " ns,"
+      << " coarse_steady_clock " << ::max_difference<flib::coarse_steady_clock, std::chrono::steady_clock>(10000) << " ns,"
+      << " tsc_system_clock " << ::max_difference<flib::tsc_system_clock, std::chrono::system_clock>(10000) << " ns,"
+      << " tsc_steady_clock " << ::max_difference<flib::tsc_steady_clock, std::chrono::steady_clock>(10000) << " ns\n";
+    std::this_thread::sleep_for(::milliseconds(250));
+  }
+  WARN(report.str());
+}
\ No newline at end of file
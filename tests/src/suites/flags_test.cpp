@@ -1,7 +1,12 @@
 // Copyright  2024 Luka Arnecic.
 // See the LICENSE file at the top-level directory of this distribution.
 
+#include <bitset>
+#include <cstddef>
 #include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
 
 #include <flib/flags.hpp>
 
@@ -30,6 +35,48 @@ namespace
     option_2345678 = 0b11111110,
     option_all     = 0b11111111
   };
+
+  enum class test_permissions
+    : uint16_t
+  {
+    read    = 0,
+    write   = 1,
+    execute = 63,
+    share   = 64,
+    audit   = 127,
+    admin   = 128,
+    last    = 299
+  };
+
+  constexpr std::size_t permission_count = 300;
+
+  using permission_set = flib::enum_bitset<::test_permissions, ::permission_count>;
+
+  // Random bitset with its std::bitset reference
+  void generate_permissions(std::mt19937_64& generator, ::permission_set& permissions,
+    std::bitset<::permission_count>& reference)
+  {
+    permissions = ::permission_set();
+    reference.reset();
+    for (std::size_t i = 0; i < ::permission_count; ++i)
+    {
+      if (0 == generator() % 3)
+      {
+        permissions.set(static_cast<::test_permissions>(i));
+        reference.set(i);
+      }
+    }
+  }
+
+  bool equal_permissions(const ::permission_set& permissions, const std::bitset<::permission_count>& reference)
+  {
+    auto result = permissions.count() == reference.count();
+    for (std::size_t i = 0; i < ::permission_count; ++i)
+    {
+      result = result && permissions.test(static_cast<::test_permissions>(i)) == reference.test(i);
+    }
+    return result;
+  }
 }
 
 TEST_CASE("Flags tests - Flag setting", "[flags]")
@@ -201,4 +248,218 @@ TEST_CASE("Flags tests - Biwise XOR", "[flags]")
     constexpr auto test_value = ::test_flags::option_123 ^ ::test_flags::option_124;
     REQUIRE(test_value == ::test_flags::option_34);
   }
+}
+
+TEST_CASE("Flags tests - Flag set", "[flags]")
+{
+  using namespace flib;
+  SECTION("Modification and testing")
+  {
+    constexpr auto test_value = flib::flag_set<::test_flags>(::test_flags::option_123).clear(::test_flags::option_2);
+    static_assert(test_value.test(::test_flags::option_1) && !test_value.test(::test_flags::option_2), "");
+    flib::flag_set<::test_flags> flags;
+    REQUIRE(flags.none());
+    REQUIRE(0 == flags.count());
+    flags.set(::test_flags::option_12).toggle(::test_flags::option_123);
+    REQUIRE(::test_flags::option_3 == flags.value());
+    REQUIRE(flags.any());
+    REQUIRE(flags.test(::test_flags::option_3));
+    REQUIRE(!flags.test(::test_flags::option_34));
+    flags |= ::test_flags::option_4;
+    REQUIRE(flags == ::test_flags::option_34);
+    REQUIRE((flags & ::test_flags::option_124) == ::test_flags::option_4);
+    REQUIRE((flags ^ ::test_flags::option_4) == ::test_flags::option_3);
+    REQUIRE(~flags == ~::test_flags::option_34);
+    REQUIRE(2 == flags.count());
+    REQUIRE(8 == flib::flag_set<::test_flags>(::test_flags::option_all).count());
+  }
+  SECTION("Iteration")
+  {
+    std::vector<::test_flags> visited;
+    flib::flag_set<::test_flags>(::test_flags::option_2345678).for_each([&visited](::test_flags p_flag)
+      {
+        visited.push_back(p_flag);
+      });
+    REQUIRE(std::vector<::test_flags>{ ::test_flags::option_2, ::test_flags::option_3, ::test_flags::option_4,
+      ::test_flags::option_5, ::test_flags::option_6, ::test_flags::option_7, ::test_flags::option_8 } == visited);
+    flib::flag_set<::test_flags>().for_each([](::test_flags)
+      {
+        FAIL("Empty flag set must not be visited");
+      });
+  }
+}
+
+TEST_CASE("Flags tests - Flag map", "[flags]")
+{
+  using namespace flib;
+  SECTION("Table translation")
+  {
+    static constexpr flib::flag_map<::test_flags, int> map{
+      { ::test_flags::option_1, 0x01 },
+      { ::test_flags::option_2, 0x20 },
+      { ::test_flags::option_3, 0x00 },
+      { ::test_flags::option_4, 0x00100000 },
+      { ::test_flags::option_8, 0x06 }
+    };
+    REQUIRE(0 == map.translate(::test_flags::option_none));
+    REQUIRE(0x21 == map.translate(::test_flags::option_12));
+    REQUIRE(0x00100021 == map.translate(::test_flags::option_1234));
+    REQUIRE(0x00100027 == map.translate(::test_flags::option_all));
+    REQUIRE(0x06 == map.translate(::test_flags::option_8 | ::test_flags::option_5));
+  }
+  SECTION("Shift translation")
+  {
+    static constexpr flib::flag_map<::test_flags, uint32_t> map{
+      { ::test_flags::option_1, 0x0100 },
+      { ::test_flags::option_2, 0x0200 },
+      { ::test_flags::option_4, 0x0800 }
+    };
+    REQUIRE(0x0300 == map.translate(::test_flags::option_12));
+    REQUIRE(0x0b00 == map.translate(::test_flags::option_all));
+    static constexpr flib::flag_map<::test_flags, uint8_t> reverse{
+      { ::test_flags::option_7, 0x02 },
+      { ::test_flags::option_8, 0x04 }
+    };
+    REQUIRE(0x06 == reverse.translate(::test_flags::option_all));
+    REQUIRE(0x00 == reverse.translate(::test_flags::option_123));
+  }
+  SECTION("Invalid entries")
+  {
+    REQUIRE_THROWS_AS((flib::flag_map<::test_flags, int>{ { ::test_flags::option_12, 1 } }), std::runtime_error);
+    REQUIRE_THROWS_AS((flib::flag_map<::test_flags, int>{ { ::test_flags::option_none, 1 } }), std::runtime_error);
+  }
+}
+
+TEST_CASE("Flags tests - Enum bitset", "[flags]")
+{
+  SECTION("Construction and single flags")
+  {
+    constexpr ::permission_set permissions{ ::test_permissions::read, ::test_permissions::share,
+      ::test_permissions::last };
+    static_assert(permissions.test(::test_permissions::share) && !permissions.test(::test_permissions::write), "");
+    static_assert(300 == ::permission_set::size(), "");
+    auto copy = permissions;
+    REQUIRE(3 == copy.count());
+    REQUIRE(copy.toggle(::test_permissions::write).test(::test_permissions::write));
+    REQUIRE(!copy.clear(::test_permissions::last).test(::test_permissions::last));
+    REQUIRE(copy.set(::test_permissions::admin).test(::test_permissions::admin));
+    std::vector<::test_permissions> visited;
+    copy.for_each([&visited](::test_permissions p_flag)
+      {
+        visited.push_back(p_flag);
+      });
+    REQUIRE(std::vector<::test_permissions>{ ::test_permissions::read, ::test_permissions::write,
+      ::test_permissions::share, ::test_permissions::admin } == visited);
+    REQUIRE_THROWS_AS(copy.set(static_cast<::test_permissions>(300)), std::runtime_error);
+    REQUIRE_THROWS_AS(copy.test(static_cast<::test_permissions>(1000)), std::runtime_error);
+  }
+  SECTION("Whole set tests")
+  {
+    ::permission_set permissions;
+    REQUIRE(permissions.none());
+    REQUIRE(!permissions.any());
+    REQUIRE(!permissions.all());
+    auto full = ~permissions;
+    REQUIRE(full.all());
+    REQUIRE(::permission_count == full.count());
+    full.clear(::test_permissions::last);
+    REQUIRE(!full.all());
+    REQUIRE(full.any());
+    REQUIRE(::permission_set{ ::test_permissions::last } == ~full);
+    REQUIRE(full != ~full);
+  }
+  SECTION("Comparison with std::bitset")
+  {
+    std::mt19937_64 generator(42);
+    for (auto i = 0; i < 1000; ++i)
+    {
+      ::permission_set permissions_1;
+      ::permission_set permissions_2;
+      std::bitset<::permission_count> reference_1;
+      std::bitset<::permission_count> reference_2;
+      ::generate_permissions(generator, permissions_1, reference_1);
+      ::generate_permissions(generator, permissions_2, reference_2);
+      REQUIRE(::equal_permissions(permissions_1 & permissions_2, reference_1 & reference_2));
+      REQUIRE(::equal_permissions(permissions_1 | permissions_2, reference_1 | reference_2));
+      REQUIRE(::equal_permissions(permissions_1 ^ permissions_2, reference_1 ^ reference_2));
+      REQUIRE(::equal_permissions(~permissions_1, ~reference_1));
+      REQUIRE((permissions_1 == permissions_2) == (reference_1 == reference_2));
+      REQUIRE(permissions_1.test(permissions_1 & permissions_2));
+      REQUIRE(permissions_1.test(permissions_2) == ((reference_1 & reference_2) == reference_2));
+      REQUIRE(permissions_1.test_any(permissions_2) == (reference_1 & reference_2).any());
+      REQUIRE(!permissions_1.test_any(~permissions_1));
+    }
+  }
+}
+
+TEST_CASE("Flags tests - Benchmarks", "[flags][.benchmark]")
+{
+  using namespace flib;
+  static constexpr flib::flag_map<::test_flags, int> map{
+    { ::test_flags::option_1, 0x01 },
+    { ::test_flags::option_2, 0x02 },
+    { ::test_flags::option_3, 0x20 },
+    { ::test_flags::option_4, 0x10 },
+    { ::test_flags::option_5, 0x00 },
+    { ::test_flags::option_6, 0x00100000 },
+    { ::test_flags::option_7, 0x00800000 },
+    { ::test_flags::option_8, 0x04000000 }
+  };
+  BENCHMARK("is_flag_set translation x256")
+  {
+    auto result = 0;
+    for (auto i = 0; i < 256; ++i)
+    {
+      auto flags = static_cast<::test_flags>(i);
+      auto translated = 0;
+      translated |= flib::is_flag_set(flags, ::test_flags::option_1) ? 0x01 : 0;
+      translated |= flib::is_flag_set(flags, ::test_flags::option_2) ? 0x02 : 0;
+      translated |= flib::is_flag_set(flags, ::test_flags::option_3) ? 0x20 : 0;
+      translated |= flib::is_flag_set(flags, ::test_flags::option_4) ? 0x10 : 0;
+      translated |= flib::is_flag_set(flags, ::test_flags::option_5) ? 0x00 : 0;
+      translated |= flib::is_flag_set(flags, ::test_flags::option_6) ? 0x00100000 : 0;
+      translated |= flib::is_flag_set(flags, ::test_flags::option_7) ? 0x00800000 : 0;
+      translated |= flib::is_flag_set(flags, ::test_flags::option_8) ? 0x04000000 : 0;
+      result ^= translated;
+    }
+    return result;
+  };
+  BENCHMARK("flag_map translation x256")
+  {
+    auto result = 0;
+    for (auto i = 0; i < 256; ++i)
+    {
+      result ^= map.translate(static_cast<::test_flags>(i));
+    }
+    return result;
+  };
+  std::mt19937_64 generator(42);
+  std::vector<::permission_set> permissions(256);
+  std::vector<std::bitset<::permission_count>> references(permissions.size());
+  for (std::size_t i = 0; i < permissions.size(); ++i)
+  {
+    ::generate_permissions(generator, permissions[i], references[i]);
+  }
+  const ::permission_set required{ ::test_permissions::read, ::test_permissions::audit };
+  std::bitset<::permission_count> required_reference;
+  required_reference.set(static_cast<std::size_t>(::test_permissions::read));
+  required_reference.set(static_cast<std::size_t>(::test_permissions::audit));
+  BENCHMARK("std::bitset subset test x256")
+  {
+    auto result = 0;
+    for (auto& reference : references)
+    {
+      result += (reference & required_reference) == required_reference ? 1 : 0;
+    }
+    return result;
+  };
+  BENCHMARK("flib::enum_bitset subset test x256")
+  {
+    auto result = 0;
+    for (auto& permission : permissions)
+    {
+      result += permission.test(required) ? 1 : 0;
+    }
+    return result;
+  };
 }
\ No newline at end of file
@@ -0,0 +1,141 @@
+// Copyright © 2024 Luka Arnecic.
+// See the LICENSE file at the top-level directory of this distribution.
+
+#include <flib/log_index.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <catch2/catch2.hpp>
+
+namespace
+{
+  using microseconds = std::chrono::duration<uint64_t, std::micro>;
+
+  struct line_t
+  {
+    std::chrono::system_clock::time_point timepoint;
+    std::size_t offset;
+  };
+
+  // Generates log file with timestamped lines, occasionally followed by lines without timestamp
+  std::vector<line_t> generate_log(const std::string& filepath, std::size_t count)
+  {
+    std::mt19937_64 generator(42);
+    std::ofstream stream(filepath, std::ios::binary | std::ios::trunc);
+    std::vector<line_t> result;
+    std::size_t offset = 0;
+    std::chrono::system_clock::time_point timepoint(::microseconds(1700000000000000ull));
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      timepoint += ::microseconds(generator() % 3 * 1000);
+      auto line = (0 == i % 2 ? "[" + flib::generate(timepoint) + "]" : flib::generate(timepoint)) + " message " +
+        std::to_string(i) + "\n";
+      if (0 == generator() % 10)
+      {
+        line += "  continuation of message " + std::to_string(i) + "\n";
+      }
+      result.push_back({ timepoint, offset });
+      stream << line;
+      offset += line.size();
+    }
+    return result;
+  }
+
+  std::size_t reference_lower_bound(const std::vector<line_t>& lines, std::chrono::system_clock::time_point timepoint,
+    std::size_t size)
+  {
+    for (auto& line : lines)
+    {
+      if (!(line.timepoint < timepoint))
+      {
+        return line.offset;
+      }
+    }
+    return size;
+  }
+}
+
+TEST_CASE("Log index tests - Sanity check", "[log_index]")
+{
+  SECTION("Default construction")
+  {
+    flib::log_index index;
+    REQUIRE(!index.opened());
+    REQUIRE(nullptr == index.data());
+    REQUIRE(0 == index.size());
+    REQUIRE_THROWS_AS(index.lower_bound(std::chrono::system_clock::now()), std::runtime_error);
+  }
+  SECTION("Missing file")
+  {
+    flib::log_index index;
+    REQUIRE_THROWS_AS(index.open("log_index_missing.log"), std::runtime_error);
+    REQUIRE(!index.opened());
+  }
+  SECTION("Empty file")
+  {
+    std::ofstream("log_index_empty.log", std::ios::trunc).close();
+    flib::log_index index("log_index_empty.log");
+    REQUIRE(index.opened());
+    REQUIRE(0 == index.size());
+    REQUIRE(0 == index.samples());
+    REQUIRE(0 == index.lower_bound(std::chrono::system_clock::now()));
+    index.close();
+    std::remove("log_index_empty.log");
+  }
+  SECTION("Unordered file")
+  {
+    std::ofstream("log_index_unordered.log", std::ios::trunc) << "2024-01-02T00:00:00Z a\n2024-01-01T00:00:00Z b\n";
+    REQUIRE_THROWS_AS(flib::log_index("log_index_unordered.log", 16), std::runtime_error);
+    std::remove("log_index_unordered.log");
+  }
+  SECTION("Nanosecond timestamps with offset")
+  {
+    std::ofstream("log_index_nanoseconds.log", std::ios::trunc) <<
+      "2024-01-02T03:04:05.123456789+01:00 a\n"
+      "[2024-01-02T03:04:06.123456789-01:00] b\n"
+      "2024-01-02T05:04:07.000000001+01:00 c\n";
+    flib::log_index index("log_index_nanoseconds.log", 1);
+    REQUIRE(3 == index.samples());
+    auto timepoint = flib::parse("2024-01-02T04:04:06Z");
+    REQUIRE(38 == index.lower_bound(timepoint));
+    REQUIRE(0 == index.lower_bound(timepoint - std::chrono::hours(3)));
+    REQUIRE(index.size() == index.lower_bound(timepoint + std::chrono::hours(1)));
+    index.close();
+    std::remove("log_index_nanoseconds.log");
+  }
+}
+
+TEST_CASE("Log index tests - Range queries", "[log_index]")
+{
+  auto lines = ::generate_log("log_index_test.log", 20000);
+  for (std::size_t stride : { std::size_t(1000), std::size_t(100000), flib::log_index::s_default_stride })
+  {
+    flib::log_index index("log_index_test.log", stride);
+    REQUIRE(index.opened());
+    REQUIRE(index.samples() <= index.size() / stride + 1);
+    std::mt19937_64 generator(stride);
+    auto first = lines.front().timepoint - std::chrono::seconds(1);
+    auto span = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(lines.back().timepoint -
+      first).count()) + 2000000;
+    for (auto i = 0; i < 200; ++i)
+    {
+      auto begin = first + ::microseconds(generator() % span);
+      auto end = begin + ::microseconds(generator() % 1000000);
+      auto range = index.find(begin, end);
+      REQUIRE(::reference_lower_bound(lines, begin, index.size()) == range.begin);
+      REQUIRE(::reference_lower_bound(lines, end, index.size()) == range.end);
+    }
+    auto range = index.find(lines[100].timepoint, lines[100].timepoint + std::chrono::microseconds(1));
+    REQUIRE(std::string::npos != std::string(index.data() + range.begin, range.end - range.begin).find(
+      "[" + flib::generate(lines[100].timepoint) + "] message 100\n"));
+  }
+  std::remove("log_index_test.log");
+}
\ No newline at end of file
@@ -0,0 +1,305 @@
+// Copyright © 2024 Luka Arnecic.
+// See the LICENSE file at the top-level directory of this distribution.
+
+#include <flib/random.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+#if defined(__linux__)
+#  include <sys/wait.h>
+#  include <unistd.h>
+#endif
+
+#include <catch2/catch2.hpp>
+
+namespace
+{
+  // Fraction of set bits at each bit position must be close to 1/2
+  template<class Generator>
+  bool check_bit_balance(Generator& generator, std::size_t samples)
+  {
+    std::size_t counts[64]{};
+    for (auto i = samples; i > 0; --i)
+    {
+      auto value = generator();
+      for (auto bit = 0; bit < 64; ++bit)
+      {
+        counts[bit] += value >> bit & 1;
+      }
+    }
+    for (auto count : counts)
+    {
+      // 6 standard deviations
+      auto deviation = static_cast<double>(count) - static_cast<double>(samples) / 2;
+      if (deviation * deviation > 36.0 * static_cast<double>(samples) / 4)
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Chi-squared statistic of byte values must be within plausible range for 255 degrees of freedom
+  template<class Generator>
+  bool check_byte_distribution(Generator& generator, std::size_t samples)
+  {
+    std::size_t counts[256]{};
+    for (auto i = samples; i > 0; --i)
+    {
+      auto value = generator();
+      for (auto byte = 0; byte < 8; ++byte)
+      {
+        ++counts[value >> 8 * byte & 0xff];
+      }
+    }
+    auto expected = static_cast<double>(samples * 8) / 256;
+    double chi_squared = 0;
+    for (auto count : counts)
+    {
+      chi_squared += (static_cast<double>(count) - expected) * (static_cast<double>(count) - expected) / expected;
+    }
+    return 180 < chi_squared && chi_squared < 340;
+  }
+}
+
+TEST_CASE("Random tests - Reference values", "[random]")
+{
+  SECTION("xoshiro256**")
+  {
+    flib::xoshiro256ss generator(42);
+    REQUIRE(0x15780b2e0c2ec716ull == generator());
+    REQUIRE(0x6104d9866d113a7eull == generator());
+    REQUIRE(0xae17533239e499a1ull == generator());
+    flib::xoshiro256ss jumped(42);
+    jumped.jump();
+    REQUIRE(0x50086ef83cbf4f4aull == jumped());
+    flib::xoshiro256ss long_jumped(42);
+    long_jumped.long_jump();
+    REQUIRE(0xa0a4cb7719d49439ull == long_jumped());
+  }
+  SECTION("wyrand")
+  {
+    flib::wyrand generator(42);
+    REQUIRE(0x57ce9f0fb367a6daull == generator());
+    REQUIRE(0xd0896df64775c178ull == generator());
+    REQUIRE(0xa4568876599a444cull == generator());
+  }
+  SECTION("chacha20")
+  {
+    // RFC 8439 block function test vector (section 2.3.2)
+    uint32_t key[8];
+    for (auto i = 0; i < 8; ++i)
+    {
+      key[i] = static_cast<uint32_t>(4 * i) | static_cast<uint32_t>(4 * i + 1) << 8 |
+        static_cast<uint32_t>(4 * i + 2) << 16 | static_cast<uint32_t>(4 * i + 3) << 24;
+    }
+    flib::chacha20 generator(key, 0x4a000000, 0x0900000000000001ull);
+    REQUIRE(0x15593bd1e4e7f110ull == generator());
+    REQUIRE(0xc47120a31fdd0f50ull == generator());
+    generator.discard(6);
+    REQUIRE(0x4ebfd7397783880aull == generator());
+    generator.discard(23);
+    REQUIRE(0x0cef9da3e7bf19a9ull == generator());
+  }
+}
+
+TEST_CASE("Random tests - Generator interface", "[random]")
+{
+  SECTION("Seeding and discarding")
+  {
+    flib::xoshiro256ss xoshiro_1(7);
+    flib::xoshiro256ss xoshiro_2(7);
+    REQUIRE(xoshiro_1 == xoshiro_2);
+    xoshiro_1();
+    xoshiro_1();
+    xoshiro_2.discard(2);
+    REQUIRE(xoshiro_1 == xoshiro_2);
+    xoshiro_2.seed(8);
+    REQUIRE(xoshiro_1 != xoshiro_2);
+    flib::wyrand wyrand_1(7);
+    flib::wyrand wyrand_2(7);
+    for (auto i = 1000; i > 0; --i)
+    {
+      wyrand_1();
+    }
+    wyrand_2.discard(1000);
+    REQUIRE(wyrand_1 == wyrand_2);
+    for (auto count : { 0u, 1u, 31u, 32u, 33u, 100u, 1000u })
+    {
+      flib::chacha20 chacha_1(7);
+      flib::chacha20 chacha_2(7);
+      chacha_1();
+      chacha_2();
+      for (auto i = count; i > 0; --i)
+      {
+        chacha_1();
+      }
+      chacha_2.discard(count);
+      REQUIRE(chacha_1 == chacha_2);
+      REQUIRE(chacha_1() == chacha_2());
+    }
+    std::seed_seq sequence{ 1u, 2u, 3u };
+    flib::xoshiro256ss seeded_xoshiro(sequence);
+    flib::wyrand seeded_wyrand(sequence);
+    REQUIRE(seeded_xoshiro != flib::xoshiro256ss());
+    REQUIRE(seeded_wyrand != flib::wyrand());
+    REQUIRE(flib::chacha20(sequence) != flib::chacha20());
+  }
+  SECTION("Standard distributions")
+  {
+    flib::xoshiro256ss xoshiro;
+    flib::wyrand wyrand;
+    std::uniform_int_distribution<int> distribution(1, 6);
+    for (auto i = 1000; i > 0; --i)
+    {
+      auto value = distribution(xoshiro);
+      REQUIRE((1 <= value && value <= 6));
+      value = distribution(wyrand);
+      REQUIRE((1 <= value && value <= 6));
+    }
+  }
+  SECTION("Jumped streams")
+  {
+    flib::xoshiro256ss generator(42);
+    std::unordered_set<uint64_t> values;
+    for (auto stream = 0; stream < 8; ++stream, generator.jump())
+    {
+      auto copy = generator;
+      for (auto i = 0; i < 1000; ++i)
+      {
+        values.insert(copy());
+      }
+    }
+    REQUIRE(8000 == values.size());
+  }
+}
+
+TEST_CASE("Random tests - Statistical sanity", "[random]")
+{
+  flib::xoshiro256ss xoshiro(42);
+  flib::wyrand wyrand(42);
+  flib::chacha20 chacha(42);
+  flib::secure_generator secure;
+  REQUIRE(::check_bit_balance(xoshiro, 100000));
+  REQUIRE(::check_bit_balance(wyrand, 100000));
+  REQUIRE(::check_bit_balance(chacha, 100000));
+  REQUIRE(::check_bit_balance(secure, 100000));
+  REQUIRE(::check_byte_distribution(xoshiro, 100000));
+  REQUIRE(::check_byte_distribution(wyrand, 100000));
+  REQUIRE(::check_byte_distribution(chacha, 100000));
+  REQUIRE(::check_byte_distribution(secure, 100000));
+}
+
+TEST_CASE("Random tests - Secure generator", "[random]")
+{
+  SECTION("Independent instances")
+  {
+    flib::secure_generator generator_1;
+    flib::secure_generator generator_2;
+    std::unordered_set<uint64_t> values;
+    // Spans several reseeds
+    for (auto i = 0; i < 1000000; ++i)
+    {
+      values.insert(generator_1());
+    }
+    for (auto i = 0; i < 1000; ++i)
+    {
+      values.insert(generator_2());
+    }
+    REQUIRE(1001000 == values.size());
+    generator_1.reseed();
+    REQUIRE(values.end() == values.find(generator_1()));
+  }
+#if defined(__linux__)
+  SECTION("Fork safety")
+  {
+    flib::secure_generator generator;
+    generator();
+    int descriptors[2];
+    REQUIRE(0 == ::pipe(descriptors));
+    auto process = ::fork();
+    REQUIRE(-1 != process);
+    if (0 == process)
+    {
+      uint64_t values[16];
+      for (auto& value : values)
+      {
+        value = generator();
+      }
+      auto written = ::write(descriptors[1], values, sizeof(values));
+      ::_exit(sizeof(values) == written ? 0 : 1);
+    }
+    ::close(descriptors[1]);
+    uint64_t child_values[16]{};
+    auto received = ::read(descriptors[0], child_values, sizeof(child_values));
+    ::close(descriptors[0]);
+    int status = 0;
+    ::waitpid(process, &status, 0);
+    REQUIRE(static_cast<ssize_t>(sizeof(child_values)) == received);
+    std::unordered_set<uint64_t> values(std::begin(child_values), std::end(child_values));
+    for (auto i = 0; i < 16; ++i)
+    {
+      values.insert(generator());
+    }
+    REQUIRE(32 == values.size());
+  }
+#endif
+}
+
+TEST_CASE("Random tests - Benchmarks", "[random][.benchmark]")
+{
+  std::mt19937_64 mt19937;
+  flib::xoshiro256ss xoshiro;
+  flib::wyrand wyrand;
+  BENCHMARK("std::mt19937_64 x1000")
+  {
+    uint64_t result = 0;
+    for (auto i = 1000; i > 0; --i)
+    {
+      result ^= mt19937();
+    }
+    return result;
+  };
+  BENCHMARK("flib::xoshiro256ss x1000")
+  {
+    uint64_t result = 0;
+    for (auto i = 1000; i > 0; --i)
+    {
+      result ^= xoshiro();
+    }
+    return result;
+  };
+  BENCHMARK("flib::wyrand x1000")
+  {
+    uint64_t result = 0;
+    for (auto i = 1000; i > 0; --i)
+    {
+      result ^= wyrand();
+    }
+    return result;
+  };
+  flib::chacha20 chacha;
+  BENCHMARK("flib::chacha20 x1000")
+  {
+    uint64_t result = 0;
+    for (auto i = 1000; i > 0; --i)
+    {
+      result ^= chacha();
+    }
+    return result;
+  };
+  flib::secure_generator secure;
+  BENCHMARK("flib::secure_generator x1000")
+  {
+    uint64_t result = 0;
+    for (auto i = 1000; i > 0; --i)
+    {
+      result ^= secure();
+    }
+    return result;
+  };
+}
\ No newline at end of file
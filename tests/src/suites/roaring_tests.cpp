@@ -0,0 +1,209 @@
+// Copyright © 2024 Luka Arnecic.
+// See the LICENSE file at the top-level directory of this distribution.
+
+#include <flib/roaring.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch2.hpp>
+
+namespace
+{
+  std::set<uint32_t> generate_values(std::mt19937& p_generator)
+  {
+    std::set<uint32_t> result;
+    // sparse values across many containers
+    for (auto i = 2000; i > 0; --i)
+    {
+      result.insert(static_cast<uint32_t>(p_generator()));
+    }
+    // dense values in single container
+    for (auto i = 10000; i > 0; --i)
+    {
+      result.insert(0x00050000ul | static_cast<uint32_t>(p_generator() & 0xffffu));
+    }
+    // consecutive values
+    for (uint32_t value = 0x00070100ul; value < 0x00072000ul; ++value)
+    {
+      result.insert(value);
+    }
+    return result;
+  }
+
+  flib::roaring_bitmap to_bitmap(const std::set<uint32_t>& p_values)
+  {
+    std::vector<uint32_t> values(p_values.cbegin(), p_values.cend());
+    return flib::roaring_bitmap(values.data(), values.data() + values.size());
+  }
+
+  std::vector<uint32_t> to_vector(const std::set<uint32_t>& p_values)
+  {
+    return std::vector<uint32_t>(p_values.cbegin(), p_values.cend());
+  }
+}
+
+TEST_CASE("Roaring bitmap tests - Sanity check", "[roaring]")
+{
+  SECTION("Default construction")
+  {
+    flib::roaring_bitmap bitmap;
+    REQUIRE(bitmap.empty());
+    REQUIRE(0 == bitmap.cardinality());
+    REQUIRE(!bitmap.contains(0));
+  }
+  SECTION("Adding and removing values")
+  {
+    flib::roaring_bitmap bitmap{ 1, 5, 0xffffffff, 5 };
+    REQUIRE(3 == bitmap.cardinality());
+    REQUIRE(bitmap.contains(1));
+    REQUIRE(bitmap.contains(5));
+    REQUIRE(bitmap.contains(0xffffffff));
+    REQUIRE(!bitmap.contains(2));
+    bitmap.remove(5);
+    bitmap.remove(6);
+    REQUIRE(2 == bitmap.cardinality());
+    REQUIRE(!bitmap.contains(5));
+    bitmap.clear();
+    REQUIRE(bitmap.empty());
+  }
+  SECTION("Container conversions")
+  {
+    flib::roaring_bitmap bitmap;
+    for (uint32_t value = 0; value < 10000; value += 2)
+    {
+      bitmap.add(value);
+    }
+    REQUIRE(5000 == bitmap.cardinality());
+    for (uint32_t value = 0; value < 10000; value += 4)
+    {
+      bitmap.remove(value);
+    }
+    REQUIRE(2500 == bitmap.cardinality());
+    REQUIRE(bitmap.contains(2));
+    REQUIRE(!bitmap.contains(4));
+  }
+}
+
+TEST_CASE("Roaring bitmap tests - Set operations", "[roaring]")
+{
+  std::mt19937 generator(42);
+  auto lhs = ::generate_values(generator);
+  auto rhs = ::generate_values(generator);
+  auto lhs_bitmap = ::to_bitmap(lhs);
+  auto rhs_bitmap = ::to_bitmap(rhs);
+  SECTION("Optimized containers")
+  {
+    lhs_bitmap.run_optimize();
+  }
+  SECTION("Regular containers")
+  {
+  }
+  REQUIRE(lhs.size() == lhs_bitmap.cardinality());
+  REQUIRE(::to_vector(lhs) == lhs_bitmap.values());
+  std::set<uint32_t> reference;
+  std::set_intersection(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend(), std::inserter(reference, reference.end()));
+  REQUIRE(::to_vector(reference) == (lhs_bitmap & rhs_bitmap).values());
+  reference.clear();
+  std::set_union(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend(), std::inserter(reference, reference.end()));
+  REQUIRE(::to_vector(reference) == (lhs_bitmap | rhs_bitmap).values());
+  reference.clear();
+  std::set_difference(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend(), std::inserter(reference, reference.end()));
+  REQUIRE(::to_vector(reference) == (lhs_bitmap - rhs_bitmap).values());
+  REQUIRE(lhs_bitmap == ::to_bitmap(lhs));
+  REQUIRE(lhs_bitmap != rhs_bitmap);
+}
+
+TEST_CASE("Roaring bitmap tests - Array container intersection", "[roaring]")
+{
+  std::mt19937 generator(42);
+  for (uint32_t lhs_size : { 0u, 1u, 7u, 8u, 9u, 63u, 1000u, 4096u })
+  {
+    for (uint32_t rhs_size : { 1u, 8u, 17u, 500u, 4096u })
+    {
+      // values of both sides are drawn from range comparable to their sizes, so that intersections are not sparse
+      auto range = 2 * std::max(lhs_size, rhs_size);
+      std::set<uint32_t> lhs;
+      std::set<uint32_t> rhs;
+      while (lhs.size() < lhs_size)
+      {
+        lhs.insert(0x00030000ul | static_cast<uint32_t>(generator() % range));
+      }
+      while (rhs.size() < rhs_size)
+      {
+        rhs.insert(0x00030000ul | static_cast<uint32_t>(generator() % range));
+      }
+      std::set<uint32_t> reference;
+      std::set_intersection(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend(),
+        std::inserter(reference, reference.end()));
+      REQUIRE(::to_vector(reference) == (::to_bitmap(lhs) & ::to_bitmap(rhs)).values());
+      REQUIRE(::to_vector(reference) == (::to_bitmap(rhs) & ::to_bitmap(lhs)).values());
+    }
+  }
+}
+
+TEST_CASE("Roaring bitmap tests - Serialization", "[roaring]")
+{
+  std::mt19937 generator(42);
+  auto values = ::generate_values(generator);
+  auto bitmap = ::to_bitmap(values);
+  SECTION("Optimized containers")
+  {
+    bitmap.run_optimize();
+  }
+  SECTION("Regular containers")
+  {
+  }
+  auto data = bitmap.serialize();
+  REQUIRE(bitmap.serialized_size() == data.size());
+  flib::roaring_view view(data.data(), data.size());
+  REQUIRE(values.size() == view.cardinality());
+  for (auto value : values)
+  {
+    REQUIRE(view.contains(value));
+  }
+  for (auto i = 1000; i > 0; --i)
+  {
+    auto value = static_cast<uint32_t>(generator());
+    REQUIRE(view.contains(value) == (values.cend() != values.find(value)));
+  }
+  REQUIRE(flib::roaring_bitmap::deserialize(data.data(), data.size()) == bitmap);
+  REQUIRE_THROWS_AS(flib::roaring_view(data.data(), data.size() - 1), std::runtime_error);
+  data[0] ^= 0xff;
+  REQUIRE_THROWS_AS(flib::roaring_view(data.data(), data.size()), std::runtime_error);
+}
+
+TEST_CASE("Roaring bitmap tests - Benchmarks", "[roaring][.benchmark]")
+{
+  std::mt19937 generator(42);
+  auto lhs = ::to_bitmap(::generate_values(generator));
+  auto rhs = ::to_bitmap(::generate_values(generator));
+  flib::roaring_bitmap lhs_arrays;
+  flib::roaring_bitmap rhs_arrays;
+  for (auto i = 4000; i > 0; --i)
+  {
+    lhs_arrays.add(static_cast<uint32_t>(generator() & 0x0003ffffu));
+    rhs_arrays.add(static_cast<uint32_t>(generator() & 0x0003ffffu));
+  }
+  BENCHMARK("Intersection")
+  {
+    return (lhs & rhs).cardinality();
+  };
+  BENCHMARK("Intersection of array containers")
+  {
+    return (lhs_arrays & rhs_arrays).cardinality();
+  };
+  BENCHMARK("Union")
+  {
+    return (lhs | rhs).cardinality();
+  };
+  BENCHMARK("Difference")
+  {
+    return (lhs - rhs).cardinality();
+  };
+}
\ No newline at end of file
@@ -3,13 +3,20 @@
 
 #include <flib/timestamp.hpp>
 
+#include <algorithm>
 #include <cstdint>
 #include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
 #include <list>
+#include <random>
 #include <ratio>
 #include <regex>
+#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 #include <catch2/catch2.hpp>
 
@@ -33,6 +40,30 @@ namespace
     auto offset = std::chrono::hours(temp.tm_hour) + std::chrono::minutes(temp.tm_min);
     return '+' == timestamp.at(timestamp.size() - 6) ? offset : -offset;
   }
+
+  // stream based formatting, used as reference for buffer generation
+  std::string generate_reference(const std::chrono::system_clock::time_point& timepoint, bool utc)
+  {
+    auto reference = std::chrono::system_clock::to_time_t(timepoint);
+    auto time_struct = utc ? flib::_impl::_time_t_tm_utc(reference) : flib::_impl::_time_t_tm_local(reference);
+    std::ostringstream stream;
+    stream << std::put_time(&time_struct, "%FT%T");
+    auto decimal = std::to_string(
+      std::chrono::duration_cast<std::chrono::microseconds>(timepoint.time_since_epoch()).count() % 1000000);
+    decimal = std::string(6 - decimal.size(), '0') + decimal;
+    auto pos = decimal.find_last_not_of('0');
+    stream << (std::string::npos != pos ? '.' + decimal.substr(0, pos + 1) : "");
+    if (utc)
+    {
+      stream << 'Z';
+      return stream.str();
+    }
+    time_struct.tm_isdst = 0;
+    auto tz_diff = (flib::_impl::_tm_time_t_utc(time_struct) - reference) / 60;
+    stream << (0 > tz_diff ? '-' : '+') << std::setw(2) << std::setfill('0') << std::abs(tz_diff) / 60 << ':'
+      << std::setw(2) << std::setfill('0') << std::abs(tz_diff) % 60;
+    return stream.str();
+  }
 }
 
 TEST_CASE("Timestamp tests - Formatting", "[timestamp]")
@@ -175,4 +206,458 @@ TEST_CASE("Timestamp tests - Generate-parse cycle equality", "[timestamp]")
   }
   REQUIRE(flib::parse(flib::generate(timepoint)) == timepoint);
   REQUIRE(flib::parse(flib::generate(timepoint, false)) == timepoint);
+}
+
+TEST_CASE("Timestamp tests - Formatter", "[timestamp]")
+{
+  char buffer[flib::max_length];
+  for (auto utc : { true, false })
+  {
+    flib::formatter formatter(utc);
+    std::chrono::system_clock::time_point timepoint(::microseconds(946684799000000));
+    for (auto i = 0; i < 3000; ++i, timepoint += ::microseconds(997))
+    {
+      auto length = formatter.format_to(buffer, sizeof(buffer), timepoint);
+      REQUIRE(std::string(buffer, length) == ::generate_reference(timepoint, utc));
+    }
+    REQUIRE(formatter.format(timepoint) == flib::generate(timepoint, utc));
+    REQUIRE(0 == formatter.format_to(buffer, 10, timepoint));
+  }
+}
+
+TEST_CASE("Timestamp tests - Format specifications", "[timestamp]")
+{
+  using namespace std::chrono;
+  const system_clock::time_point timepoint(duration_cast<system_clock::duration>(nanoseconds(946684799120000000)));
+  const system_clock::time_point whole(seconds(946684800));
+  SECTION("Default format")
+  {
+    std::mt19937_64 generator(42);
+    for (auto i = 1000; i > 0; --i)
+    {
+      system_clock::time_point reference(::microseconds(generator() % 7258118399999999ull));
+      REQUIRE(flib::format<>::generate(reference) == flib::generate(reference));
+      REQUIRE(flib::format<>::generate(reference, false) == flib::generate(reference, false));
+    }
+  }
+  SECTION("Precision")
+  {
+    REQUIRE("1999-12-31T23:59:59Z" == flib::format<flib::precision_t::seconds>::generate(timepoint));
+    REQUIRE("1999-12-31T23:59:59.12Z" == flib::format<flib::precision_t::millis>::generate(timepoint));
+    REQUIRE("1999-12-31T23:59:59.120Z" == flib::format<flib::precision_t::millis, flib::trim_t::no>::generate(timepoint));
+    REQUIRE("1999-12-31T23:59:59.120000Z" ==
+      flib::format<flib::precision_t::micros, flib::trim_t::no>::generate(timepoint));
+    REQUIRE("2000-01-01T00:00:00.000000000Z" ==
+      flib::format<flib::precision_t::nanos, flib::trim_t::no>::generate(whole));
+    REQUIRE("2000-01-01T00:00:00Z" == flib::format<flib::precision_t::nanos>::generate(whole));
+  }
+  SECTION("Separator and style")
+  {
+    using format_t = flib::format<flib::precision_t::millis, flib::trim_t::no, flib::separator_t::space, flib::style_t::basic>;
+    REQUIRE("19991231 235959.120Z" == format_t::generate(timepoint));
+    REQUIRE(format_t::length() == format_t::generate(timepoint).size());
+    REQUIRE(format_t::length(false) == format_t::generate(timepoint, false).size());
+    REQUIRE(flib::format<>::generate(timepoint, false).substr(0, 10) ==
+      flib::format<flib::precision_t::seconds, flib::trim_t::yes, flib::separator_t::space>::generate(timepoint, false).substr(0, 10));
+  }
+  SECTION("Fixed length")
+  {
+    using format_t = flib::format<flib::precision_t::nanos, flib::trim_t::no>;
+    static_assert(30 == format_t::length(), "Invalid format length");
+    static_assert(35 == format_t::length(false), "Invalid format length");
+    char buffer[format_t::length()];
+    REQUIRE(0 == format_t::generate_to(buffer, sizeof(buffer) - 1, timepoint));
+    REQUIRE(sizeof(buffer) == format_t::generate_to(buffer, sizeof(buffer), timepoint));
+  }
+}
+
+TEST_CASE("Timestamp tests - Civil calendar conversion", "[timestamp]")
+{
+  SECTION("Compile-time conversion")
+  {
+    static_assert(0 == flib::_impl::_days_from_civil(1970, 1, 1), "Invalid days from civil conversion");
+    static_assert(-1 == flib::_impl::_days_from_civil(1969, 12, 31), "Invalid days from civil conversion");
+    static_assert(10957 == flib::_impl::_days_from_civil(2000, 1, 1), "Invalid days from civil conversion");
+    static_assert(-719468 == flib::_impl::_days_from_civil(0, 3, 1), "Invalid days from civil conversion");
+    static_assert(2000 == flib::_impl::_civil_from_days(11016).year, "Invalid civil from days conversion");
+    static_assert(2 == flib::_impl::_civil_from_days(11016).month, "Invalid civil from days conversion");
+    static_assert(29 == flib::_impl::_civil_from_days(11016).day, "Invalid civil from days conversion");
+  }
+  SECTION("Round trip")
+  {
+    for (int64_t days = -1000000; days < 3000000; days += 97)
+    {
+      auto civil = flib::_impl::_civil_from_days(days);
+      REQUIRE(days == flib::_impl::_days_from_civil(civil.year, civil.month, civil.day));
+    }
+  }
+  SECTION("Time structure conversion")
+  {
+    auto time_struct = flib::_impl::_time_t_tm_utc(951825599);
+    REQUIRE(100 == time_struct.tm_year);
+    REQUIRE(1 == time_struct.tm_mon);
+    REQUIRE(29 == time_struct.tm_mday);
+    REQUIRE(11 == time_struct.tm_hour);
+    REQUIRE(59 == time_struct.tm_min);
+    REQUIRE(59 == time_struct.tm_sec);
+    REQUIRE(2 == time_struct.tm_wday);
+    REQUIRE(59 == time_struct.tm_yday);
+    REQUIRE(951825599 == flib::_impl::_tm_time_t_utc(time_struct));
+    time_struct.tm_mon += 13;
+    time_struct.tm_mday -= 29;
+    REQUIRE(951825599 + 365 * 86400 == flib::_impl::_tm_time_t_utc(time_struct));
+    REQUIRE(-1 == flib::_impl::_tm_time_t_utc(flib::_impl::_time_t_tm_utc(-1)));
+  }
+}
+
+TEST_CASE("Timestamp tests - Buffer generation", "[timestamp]")
+{
+  std::mt19937_64 generator(42);
+  char buffer[flib::max_length];
+  SECTION("Equality with string generation")
+  {
+    for (auto i = 1000; i > 0; --i)
+    {
+      std::chrono::system_clock::time_point timepoint(::microseconds(generator() % 7258118399999999ull));
+      for (auto utc : { true, false })
+      {
+        auto length = flib::generate_to(buffer, sizeof(buffer), timepoint, utc);
+        REQUIRE(std::string(buffer, length) == ::generate_reference(timepoint, utc));
+        REQUIRE(std::string(buffer, length) == flib::generate(timepoint, utc));
+      }
+    }
+  }
+  SECTION("Whole seconds")
+  {
+    std::chrono::system_clock::time_point timepoint(::microseconds(946684800000000));
+    REQUIRE(20 == flib::generate_to(buffer, sizeof(buffer), timepoint));
+    REQUIRE("2000-01-01T00:00:00Z" == std::string(buffer, 20));
+  }
+  SECTION("Insufficient buffer")
+  {
+    std::chrono::system_clock::time_point timepoint(::microseconds(946684799999999));
+    REQUIRE(0 == flib::generate_to(buffer, 26, timepoint));
+    REQUIRE(27 == flib::generate_to(buffer, 27, timepoint));
+  }
+}
+
+#if !defined(_WIN32)
+TEST_CASE("Timestamp tests - Timezone cache", "[timestamp]")
+{
+  const auto* original = std::getenv("TZ");
+  const std::string original_tz = nullptr != original ? original : "";
+  setenv("TZ", "America/New_York", 1);
+  flib::reload_timezone();
+  SECTION("Daylight saving time start")
+  {
+    std::chrono::system_clock::time_point timepoint(std::chrono::seconds(1710053999));
+    REQUIRE("2024-03-10T01:59:59-05:00" == flib::generate(timepoint, false));
+    REQUIRE("2024-03-10T03:00:00-04:00" == flib::generate(timepoint + std::chrono::seconds(1), false));
+    REQUIRE("2024-03-10T01:59:59-05:00" == flib::generate(timepoint, false));
+  }
+  SECTION("Daylight saving time end")
+  {
+    std::chrono::system_clock::time_point timepoint(std::chrono::seconds(1730613599));
+    REQUIRE("2024-11-03T01:59:59-04:00" == flib::generate(timepoint, false));
+    REQUIRE("2024-11-03T01:00:00-05:00" == flib::generate(timepoint + std::chrono::seconds(1), false));
+  }
+  SECTION("Timezone reload")
+  {
+    std::chrono::system_clock::time_point timepoint(std::chrono::seconds(1718755200));
+    REQUIRE("2024-06-18T20:00:00-04:00" == flib::generate(timepoint, false));
+    setenv("TZ", "Asia/Kolkata", 1);
+    flib::reload_timezone();
+    REQUIRE("2024-06-19T05:30:00+05:30" == flib::generate(timepoint, false));
+  }
+  if (nullptr != original)
+  {
+    setenv("TZ", original_tz.c_str(), 1);
+  }
+  else
+  {
+    unsetenv("TZ");
+  }
+  flib::reload_timezone();
+}
+#endif
+
+TEST_CASE("Timestamp tests - Generation benchmarks", "[timestamp][.benchmark]")
+{
+  auto timepoint = std::chrono::system_clock::now();
+  char buffer[flib::max_length];
+  BENCHMARK("generate (UTC)")
+  {
+    return flib::generate(timepoint);
+  };
+  BENCHMARK("generate_to (UTC)")
+  {
+    return flib::generate_to(buffer, sizeof(buffer), timepoint);
+  };
+  BENCHMARK("generate_to (local)")
+  {
+    return flib::generate_to(buffer, sizeof(buffer), timepoint, false);
+  };
+  BENCHMARK("format<nanos, no trim> (UTC)")
+  {
+    return flib::format<flib::precision_t::nanos, flib::trim_t::no>::generate_to(buffer, sizeof(buffer), timepoint);
+  };
+  flib::formatter formatter;
+  BENCHMARK("formatter (UTC, same second)")
+  {
+    return formatter.format_to(buffer, sizeof(buffer), timepoint);
+  };
+  BENCHMARK("formatter (UTC, changing second)")
+  {
+    timepoint += std::chrono::seconds(1);
+    return formatter.format_to(buffer, sizeof(buffer), timepoint);
+  };
+}
+
+TEST_CASE("Timestamp tests - Buffer parsing", "[timestamp]")
+{
+  std::chrono::system_clock::time_point timepoint;
+  auto parse = [&timepoint](const std::string& timestamp)
+    {
+      return flib::parse(timestamp.data(), timestamp.size(), timepoint);
+    };
+  SECTION("Valid timestamps")
+  {
+    REQUIRE(flib::parse_status_t::ok == parse("1999-12-31t23:59:59.999999z"));
+    REQUIRE(timepoint == std::chrono::system_clock::time_point(::microseconds(946684799999999)));
+    REQUIRE(flib::parse_status_t::ok == parse("2000-01-01T01:00:00.5+01:00"));
+    REQUIRE(timepoint == std::chrono::system_clock::time_point(::microseconds(946684800500000)));
+    REQUIRE(flib::parse_status_t::ok == parse("2000-02-29T00:00:00.000000001Z"));
+    REQUIRE(std::chrono::system_clock::time_point(std::chrono::seconds(951782400)) +
+      std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(1)) == timepoint);
+  }
+  SECTION("Invalid timestamps")
+  {
+    timepoint = {};
+    REQUIRE(flib::parse_status_t::invalid_format == parse(""));
+    REQUIRE(flib::parse_status_t::invalid_format == parse("2000-01-01T00:00:00"));
+    REQUIRE(flib::parse_status_t::invalid_format == parse("2000-01-01 00:00:00Z"));
+    REQUIRE(flib::parse_status_t::invalid_format == parse("2000-01-0a T00:00:00Z"));
+    REQUIRE(flib::parse_status_t::invalid_format == parse("2000/01/01T00:00:00Z"));
+    REQUIRE(flib::parse_status_t::invalid_format == parse("2000-01-01T00:00:00.Z"));
+    REQUIRE(flib::parse_status_t::invalid_format == parse("2000-01-01T00:00:00ZZ"));
+    REQUIRE(flib::parse_status_t::invalid_format == parse("2000-01-01T00:00:00+0100"));
+    REQUIRE(flib::parse_status_t::invalid_date == parse("2000-13-01T00:00:00Z"));
+    REQUIRE(flib::parse_status_t::invalid_date == parse("1900-02-29T00:00:00Z"));
+    REQUIRE(flib::parse_status_t::invalid_time == parse("2000-01-01T24:00:00Z"));
+    REQUIRE(flib::parse_status_t::invalid_offset == parse("2000-01-01T00:00:00+01:60"));
+    REQUIRE(std::chrono::system_clock::time_point() == timepoint);
+    REQUIRE_THROWS_AS(flib::parse("2000-01-01T00:00:00"), std::runtime_error);
+  }
+  SECTION("Generate-parse cycle equality")
+  {
+    std::mt19937_64 generator(42);
+    char buffer[flib::max_length];
+    for (auto i = 1000; i > 0; --i)
+    {
+      std::chrono::system_clock::time_point reference(::microseconds(generator() % 7258118399999999ull));
+      for (auto utc : { true, false })
+      {
+        REQUIRE(flib::parse_status_t::ok ==
+          flib::parse(buffer, flib::generate_to(buffer, sizeof(buffer), reference, utc), timepoint));
+        REQUIRE(reference == timepoint);
+      }
+    }
+  }
+}
+
+TEST_CASE("Timestamp tests - Bulk parsing", "[timestamp]")
+{
+  std::chrono::system_clock::time_point timepoints[70];
+  uint64_t failed[2] = { ~0ull, ~0ull };
+  SECTION("Row pointers")
+  {
+    const std::vector<std::string> timestamps = { "1999-12-31T23:59:59.999999Z", "2000-01-01T00:00:00.000001Z",
+      "2000-01-01T01:00:00.5+01:00", "2000-01-01T00:00:00.00000aZ", "2000-13-01T00:00:00.000000Z",
+      "2000-01-01T00:00:01.000000z", "invalid" };
+    std::vector<const char*> rows;
+    std::vector<std::size_t> sizes;
+    for (auto& timestamp : timestamps)
+    {
+      rows.push_back(timestamp.c_str());
+      sizes.push_back(timestamp.size());
+    }
+    REQUIRE(4 == flib::parse_many(rows.data(), rows.data() + rows.size(), sizes.data(), timepoints, failed));
+    REQUIRE(0x58u == failed[0]);
+    REQUIRE(std::chrono::system_clock::time_point(::microseconds(946684799999999)) == timepoints[0]);
+    REQUIRE(std::chrono::system_clock::time_point(::microseconds(946684800000001)) == timepoints[1]);
+    REQUIRE(std::chrono::system_clock::time_point(::microseconds(946684800500000)) == timepoints[2]);
+    REQUIRE(std::chrono::system_clock::time_point(::microseconds(946684801000000)) == timepoints[5]);
+    REQUIRE(4 == flib::parse_many(rows.data(), rows.data() + rows.size(), nullptr, timepoints));
+  }
+  SECTION("Strided buffer")
+  {
+    std::mt19937_64 generator(42);
+    std::string column;
+    std::chrono::system_clock::time_point references[70];
+    char buffer[flib::max_length];
+    for (auto& reference : references)
+    {
+      reference = std::chrono::system_clock::time_point(::microseconds(generator() % 7258118399999999ull));
+      auto size = flib::format<flib::precision_t::micros, flib::trim_t::no>::generate_to(buffer, sizeof(buffer),
+        reference, false);
+      column.append(buffer, size).append(flib::max_length - size, ' ').append(1, ',');
+    }
+    column.replace(65 * (flib::max_length + 1) + 2, 1, "x");
+    REQUIRE(69 == flib::parse_many(column.data(), flib::max_length, flib::max_length + 1, 70, timepoints, failed));
+    REQUIRE(0 == failed[0]);
+    REQUIRE(0x2u == failed[1]);
+    for (auto i = 0; i < 70; ++i)
+    {
+      REQUIRE((65 == i || references[i] == timepoints[i]));
+    }
+  }
+}
+
+TEST_CASE("Timestamp tests - Binary encoding", "[timestamp]")
+{
+  SECTION("Fixed-length encoding")
+  {
+    uint8_t binary[flib::binary_length];
+    flib::to_binary(binary, std::chrono::system_clock::time_point(::microseconds(1)));
+    REQUIRE(0 == std::memcmp(binary, "\x80\x00\x00\x00\x00\x00\x00\x01", sizeof(binary)));
+    flib::to_binary(binary, std::chrono::system_clock::time_point(-std::chrono::microseconds(1)));
+    REQUIRE(0 == std::memcmp(binary, "\x7f\xff\xff\xff\xff\xff\xff\xff", sizeof(binary)));
+    flib::to_binary(binary, std::chrono::system_clock::time_point(std::chrono::nanoseconds(-1)), flib::precision_t::millis);
+    std::chrono::system_clock::time_point timepoint;
+    REQUIRE(flib::parse_status_t::ok == flib::from_binary(binary, timepoint, flib::precision_t::millis));
+    REQUIRE(std::chrono::system_clock::time_point(-std::chrono::milliseconds(1)) == timepoint);
+  }
+  SECTION("Out of range")
+  {
+    // ticks beyond range of nanoseconds since epoch (year 2262)
+    uint8_t binary[flib::binary_length];
+    char buffer[flib::max_length];
+    std::chrono::system_clock::time_point timepoint;
+    std::memcpy(binary, "\x80\x40\x00\x00\x00\x00\x00\x00", sizeof(binary));
+    REQUIRE(flib::parse_status_t::ok == flib::from_binary(binary, timepoint, flib::precision_t::nanos));
+    REQUIRE(flib::parse_status_t::out_of_range == flib::from_binary(binary, timepoint));
+    REQUIRE(0 == flib::from_binary(buffer, sizeof(buffer), binary));
+    std::memcpy(binary, "\x7f\xc0\x00\x00\x00\x00\x00\x00", sizeof(binary));
+    REQUIRE(flib::parse_status_t::out_of_range == flib::from_binary(binary, timepoint));
+    std::memcpy(binary, "\x80\x00\x00\x00\x00\x00\x00\x01", sizeof(binary));
+    REQUIRE(flib::parse_status_t::ok == flib::from_binary(binary, timepoint));
+    REQUIRE(std::chrono::system_clock::time_point(::microseconds(1)) == timepoint);
+  }
+  SECTION("Order preservation")
+  {
+    std::mt19937_64 generator(42);
+    for (auto precision : { flib::precision_t::micros, flib::precision_t::nanos })
+    {
+      for (auto i = 1000; i > 0; --i)
+      {
+        std::chrono::system_clock::time_point timepoints[2] = {
+          std::chrono::system_clock::time_point(std::chrono::nanoseconds(static_cast<int64_t>(generator()) >> 2)),
+          std::chrono::system_clock::time_point(std::chrono::nanoseconds(static_cast<int64_t>(generator()) >> 2)) };
+        uint8_t binaries[2][flib::binary_length];
+        flib::to_binary(binaries[0], timepoints[0], precision);
+        flib::to_binary(binaries[1], timepoints[1], precision);
+        auto order = std::memcmp(binaries[0], binaries[1], flib::binary_length);
+        REQUIRE((timepoints[0] < timepoints[1]) == (order < 0));
+        if (flib::precision_t::nanos == precision)
+        {
+          std::chrono::system_clock::time_point timepoint;
+          REQUIRE(flib::parse_status_t::ok == flib::from_binary(binaries[0], timepoint, precision));
+          REQUIRE(timepoints[0] == timepoint);
+        }
+      }
+    }
+  }
+  SECTION("Timestamp conversion")
+  {
+    uint8_t binary[flib::binary_length];
+    char buffer[flib::max_length];
+    REQUIRE(flib::parse_status_t::ok == flib::to_binary(binary, "2000-01-01T01:00:00.5+01:00", 27));
+    std::chrono::system_clock::time_point timepoint;
+    REQUIRE(flib::parse_status_t::ok == flib::from_binary(binary, timepoint));
+    REQUIRE(std::chrono::system_clock::time_point(::microseconds(946684800500000)) == timepoint);
+    REQUIRE("2000-01-01T00:00:00.5Z" == std::string(buffer, flib::from_binary(buffer, sizeof(buffer), binary)));
+    REQUIRE(flib::parse_status_t::invalid_date == flib::to_binary(binary, "2000-13-01T00:00:00Z", 20));
+  }
+  SECTION("Delta stream")
+  {
+    std::mt19937_64 generator(42);
+    std::vector<std::chrono::system_clock::time_point> timepoints;
+    auto timepoint = std::chrono::system_clock::time_point(::microseconds(1700000000000000ull));
+    for (auto i = 1000; i > 0; --i)
+    {
+      timepoints.push_back(timepoint += ::microseconds(generator() % 8000));
+    }
+    auto stream = flib::encode_stream(timepoints.data(), timepoints.data() + timepoints.size());
+    REQUIRE(stream.size() < 8 + 2 * timepoints.size());
+    REQUIRE(timepoints == flib::decode_stream(stream.data(), stream.size()));
+    std::reverse(timepoints.begin(), timepoints.end());
+    stream = flib::encode_stream(timepoints.data(), timepoints.data() + timepoints.size(), flib::precision_t::nanos);
+    REQUIRE(timepoints == flib::decode_stream(stream.data(), stream.size(), flib::precision_t::nanos));
+    REQUIRE(flib::decode_stream(nullptr, 0).empty());
+    REQUIRE_THROWS_AS(flib::decode_stream(stream.data(), 1), std::runtime_error);
+    // single delta of 2^62 microseconds, beyond range of nanoseconds since epoch
+    const uint8_t overflow[] = { 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x01 };
+    REQUIRE(1 == flib::decode_stream(overflow, sizeof(overflow), flib::precision_t::nanos).size());
+    REQUIRE_THROWS_AS(flib::decode_stream(overflow, sizeof(overflow)), std::runtime_error);
+    // 10-byte varint with bits beyond 64-bit value
+    const uint8_t overlong[] = { 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x02 };
+    REQUIRE_THROWS_AS(flib::decode_stream(overlong, sizeof(overlong), flib::precision_t::nanos), std::runtime_error);
+  }
+}
+
+TEST_CASE("Timestamp tests - Parsing benchmarks", "[timestamp][.benchmark]")
+{
+  const std::string timestamp = "2024-06-30T12:34:56.789012+02:00";
+  std::chrono::system_clock::time_point timepoint;
+  BENCHMARK("parse (string)")
+  {
+    return flib::parse(timestamp);
+  };
+  BENCHMARK("parse (buffer)")
+  {
+    return flib::parse(timestamp.data(), timestamp.size(), timepoint);
+  };
+  std::vector<std::string> timestamps(1000, timestamp);
+  std::vector<const char*> rows;
+  std::vector<std::size_t> sizes(timestamps.size(), timestamp.size());
+  std::string column;
+  for (auto& row : timestamps)
+  {
+    rows.push_back(row.c_str());
+    column += row;
+  }
+  std::vector<std::chrono::system_clock::time_point> timepoints(timestamps.size());
+  std::vector<uint64_t> failed((timestamps.size() + 63) / 64);
+  BENCHMARK("parse (buffer) x1000")
+  {
+    for (std::size_t i = 0; i < rows.size(); ++i)
+    {
+      flib::parse(rows[i], sizes[i], timepoints[i]);
+    }
+    return timepoints.back();
+  };
+  BENCHMARK("parse_many (row pointers) x1000")
+  {
+    return flib::parse_many(rows.data(), rows.data() + rows.size(), sizes.data(), timepoints.data(), failed.data());
+  };
+  BENCHMARK("parse_many (strided) x1000")
+  {
+    return flib::parse_many(column.data(), timestamp.size(), timestamp.size(), timepoints.size(), timepoints.data(),
+      failed.data());
+  };
+  uint8_t binary[flib::binary_length];
+  flib::to_binary(binary, flib::parse(timestamp));
+  BENCHMARK("to_binary (buffer)")
+  {
+    return flib::to_binary(binary, timestamp.data(), timestamp.size());
+  };
+  BENCHMARK("from_binary (buffer)")
+  {
+    char buffer[flib::max_length];
+    return flib::from_binary(buffer, sizeof(buffer), binary);
+  };
+  BENCHMARK("encode_stream x1000")
+  {
+    return flib::encode_stream(timepoints.data(), timepoints.data() + timepoints.size());
+  };
 }
\ No newline at end of file
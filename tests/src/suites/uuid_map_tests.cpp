@@ -0,0 +1,276 @@
+// Copyright © 2024 Luka Arnecic.
+// See the LICENSE file at the top-level directory of this distribution.
+
+#include <flib/uuid_map.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch2.hpp>
+
+namespace
+{
+  std::vector<flib::uuid_t> generate_uuids(std::size_t count)
+  {
+    std::vector<flib::uuid_t> result(count);
+    flib::generate_n(result.data(), result.size());
+    return result;
+  }
+
+  // Uuids with equal trailing bytes, which share group and control byte
+  std::vector<flib::uuid_t> generate_colliding_uuids(std::size_t count)
+  {
+    std::vector<flib::uuid_t> result(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      result[i].bytes.fill(0);
+      result[i].bytes[0] = static_cast<uint8_t>(i);
+      result[i].bytes[1] = static_cast<uint8_t>(i >> 8);
+      result[i].bytes[2] = static_cast<uint8_t>(i >> 16);
+    }
+    return result;
+  }
+}
+
+TEST_CASE("Uuid map tests - Set", "[uuid_map]")
+{
+  auto uuids = ::generate_uuids(1000);
+  SECTION("Insertion and lookup")
+  {
+    flib::uuid_set set;
+    REQUIRE(set.empty());
+    REQUIRE(!set.contains(uuids[0]));
+    REQUIRE(!set.erase(uuids[0]));
+    for (auto& uuid : uuids)
+    {
+      REQUIRE(set.insert(uuid));
+      REQUIRE(!set.insert(uuid));
+    }
+    REQUIRE(uuids.size() == set.size());
+    REQUIRE(set.size() <= set.capacity() - set.capacity() / 8);
+    for (auto& uuid : uuids)
+    {
+      REQUIRE(set.contains(uuid));
+    }
+    std::unordered_set<flib::uuid_t> visited;
+    set.for_each([&visited](const flib::uuid_t& p_uuid)
+      {
+        visited.insert(p_uuid);
+      });
+    REQUIRE(std::unordered_set<flib::uuid_t>(uuids.begin(), uuids.end()) == visited);
+    set.clear();
+    REQUIRE(set.empty());
+    REQUIRE(!set.contains(uuids[0]));
+  }
+  SECTION("Construction and assignment")
+  {
+    flib::uuid_set set{ uuids[0], uuids[1], uuids[2], uuids[0] };
+    REQUIRE(3 == set.size());
+    auto copy = set;
+    REQUIRE(copy.erase(uuids[0]));
+    REQUIRE(2 == copy.size());
+    REQUIRE(set.contains(uuids[0]));
+    auto moved = std::move(set);
+    REQUIRE(3 == moved.size());
+    moved = copy;
+    REQUIRE(2 == moved.size());
+    REQUIRE(!moved.contains(uuids[0]));
+  }
+  SECTION("Reservation")
+  {
+    flib::uuid_set set;
+    set.reserve(uuids.size());
+    auto capacity = set.capacity();
+    for (auto& uuid : uuids)
+    {
+      set.insert(uuid);
+    }
+    REQUIRE(capacity == set.capacity());
+  }
+  SECTION("Colliding keys")
+  {
+    // Keys sharing trailing bytes would be probed linearly without mixing of both halves
+    auto colliding = ::generate_colliding_uuids(100000);
+    flib::uuid_set set(std::initializer_list<flib::uuid_t>{});
+    for (auto& uuid : colliding)
+    {
+      REQUIRE(set.insert(uuid));
+    }
+    for (std::size_t i = 0; i < colliding.size(); i += 2)
+    {
+      REQUIRE(set.erase(colliding[i]));
+    }
+    for (std::size_t i = 0; i < colliding.size(); ++i)
+    {
+      REQUIRE((1 == i % 2) == set.contains(colliding[i]));
+    }
+  }
+}
+
+TEST_CASE("Uuid map tests - Map", "[uuid_map]")
+{
+  auto uuids = ::generate_uuids(2000);
+  SECTION("Insertion and lookup")
+  {
+    flib::uuid_map<std::string> map;
+    for (std::size_t i = 0; i < uuids.size(); ++i)
+    {
+      REQUIRE(map.emplace(uuids[i], 3, static_cast<char>('a' + i % 26)));
+    }
+    REQUIRE(!map.emplace(uuids[0], "other"));
+    map[uuids[1]] += "!";
+    REQUIRE(map[flib::from_string("00000000-0000-4000-8000-000000000000")].empty());
+    REQUIRE(uuids.size() + 1 == map.size());
+    REQUIRE("aaa" == *map.find(uuids[0]));
+    REQUIRE("bbb!" == *map.find(uuids[1]));
+    const auto& const_map = map;
+    REQUIRE("ccc" == *const_map.find(uuids[2]));
+    REQUIRE(map.erase(uuids[2]));
+    REQUIRE(nullptr == const_map.find(uuids[2]));
+    std::size_t count = 0;
+    map.for_each([&count](const flib::uuid_t&, std::string& p_value)
+      {
+        p_value += "?";
+        ++count;
+      });
+    REQUIRE(map.size() == count);
+    const_map.for_each([](const flib::uuid_t&, const std::string& p_value)
+      {
+        REQUIRE('?' == p_value.back());
+      });
+  }
+  SECTION("Move-only values")
+  {
+    flib::uuid_map<std::unique_ptr<int>> map;
+    for (std::size_t i = 0; i < uuids.size(); ++i)
+    {
+      map.emplace(uuids[i], new int(static_cast<int>(i)));
+    }
+    for (std::size_t i = 0; i < uuids.size(); ++i)
+    {
+      REQUIRE(static_cast<int>(i) == **map.find(uuids[i]));
+    }
+    auto moved = std::move(map);
+    REQUIRE(uuids.size() == moved.size());
+    REQUIRE(map.empty());
+  }
+  SECTION("Random operations")
+  {
+    flib::uuid_map<std::size_t> map;
+    std::unordered_map<flib::uuid_t, std::size_t> reference;
+    std::mt19937_64 generator(42);
+    for (std::size_t i = 0; i < 200000; ++i)
+    {
+      auto& uuid = uuids[generator() % uuids.size()];
+      switch (generator() % 4)
+      {
+      case 0:
+        REQUIRE(reference.emplace(uuid, i).second == map.emplace(uuid, i));
+        break;
+      case 1:
+        REQUIRE((1 == reference.erase(uuid)) == map.erase(uuid));
+        break;
+      case 2:
+        map[uuid] = i;
+        reference[uuid] = i;
+        break;
+      default:
+        {
+          auto it = reference.find(uuid);
+          auto value = map.find(uuid);
+          REQUIRE((reference.end() == it) == (nullptr == value));
+          REQUIRE((reference.end() == it || it->second == *value));
+        }
+        break;
+      }
+      REQUIRE(reference.size() == map.size());
+    }
+    auto copy = map;
+    for (auto& uuid : uuids)
+    {
+      auto it = reference.find(uuid);
+      auto value = copy.find(uuid);
+      REQUIRE((reference.end() == it) == (nullptr == value));
+      REQUIRE((reference.end() == it || it->second == *value));
+    }
+  }
+}
+
+TEST_CASE("Uuid map tests - Benchmarks", "[uuid_map][.benchmark]")
+{
+  static constexpr std::size_t count = 1000000;
+  auto uuids = ::generate_uuids(count);
+  std::vector<std::string> texts;
+  texts.reserve(count);
+  for (auto& uuid : uuids)
+  {
+    texts.push_back(flib::to_string(uuid));
+  }
+  flib::uuid_map<uint64_t> map;
+  std::unordered_map<flib::uuid_t, uint64_t> uuid_map;
+  std::unordered_map<std::string, uint64_t> string_map;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    map.emplace(uuids[i], i);
+    uuid_map.emplace(uuids[i], i);
+    string_map.emplace(texts[i], i);
+  }
+  std::mt19937_64 generator(42);
+  std::vector<std::size_t> order(10000);
+  for (auto& index : order)
+  {
+    index = generator() % count;
+  }
+  BENCHMARK("std::unordered_map<std::string> find x10000")
+  {
+    uint64_t result = 0;
+    for (auto index : order)
+    {
+      result += string_map.find(texts[index])->second;
+    }
+    return result;
+  };
+  BENCHMARK("std::unordered_map<flib::uuid_t> find x10000")
+  {
+    uint64_t result = 0;
+    for (auto index : order)
+    {
+      result += uuid_map.find(uuids[index])->second;
+    }
+    return result;
+  };
+  BENCHMARK("flib::uuid_map find x10000")
+  {
+    uint64_t result = 0;
+    for (auto index : order)
+    {
+      result += *map.find(uuids[index]);
+    }
+    return result;
+  };
+  BENCHMARK("std::unordered_map<flib::uuid_t> insert x10000")
+  {
+    std::unordered_map<flib::uuid_t, uint64_t> result;
+    for (std::size_t i = 0; i < 10000; ++i)
+    {
+      result.emplace(uuids[i], i);
+    }
+    return result.size();
+  };
+  BENCHMARK("flib::uuid_map insert x10000")
+  {
+    flib::uuid_map<uint64_t> result;
+    for (std::size_t i = 0; i < 10000; ++i)
+    {
+      result.emplace(uuids[i], i);
+    }
+    return result.size();
+  };
+}
\ No newline at end of file
@@ -3,8 +3,19 @@
 
 #include <flib/uuid.hpp>
 
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <functional>
+#include <random>
 #include <regex>
+#include <stdexcept>
 #include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include <catch2/catch2.hpp>
 
@@ -15,6 +26,39 @@ namespace
     static const std::regex regex("^[0-9a-f]{8}-[0-9a-f]{4}-4[0-9a-f]{3}-[89ab][0-9a-f]{3}-[0-9a-f]{12}$", std::regex_constants::icase);
     return std::regex_match(uuid, regex);
   }
+
+  bool check_uuid_v7(const std::string& uuid)
+  {
+    static const std::regex regex("^[0-9a-f]{8}-[0-9a-f]{4}-7[0-9a-f]{3}-[89ab][0-9a-f]{3}-[0-9a-f]{12}$", std::regex_constants::icase);
+    return std::regex_match(uuid, regex);
+  }
+
+  bool check_ulid(const std::string& ulid)
+  {
+    static const std::regex regex("^[0-7][0-9a-hjkmnp-tv-z]{25}$", std::regex_constants::icase);
+    static const std::regex aliases("[ilo]", std::regex_constants::icase);
+    return std::regex_match(std::regex_replace(ulid, aliases, "0"), regex);
+  }
+
+  // Returns shortest of several runs generating 100000 binary uuids with given function
+  template<class Function>
+  std::chrono::nanoseconds shortest_generation(Function generate)
+  {
+    flib::uuid_t uuid;
+    auto result = std::chrono::nanoseconds::max();
+    for (auto run = 5; run > 0; --run)
+    {
+      auto start = std::chrono::steady_clock::now();
+      for (auto i = 100000; i > 0; --i)
+      {
+        generate(uuid);
+      }
+      result = std::min(result, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+        start));
+    }
+    REQUIRE(0x40 == (uuid.bytes[6] & 0xf0));
+    return result;
+  }
 }
 
 TEST_CASE("Uuid tests - Formatting", "[uuid]")
@@ -69,4 +113,537 @@ TEST_CASE("Uuid tests - Generate-test cycle equality", "[uuid]")
       REQUIRE(flib::test(flib::generate()));
     }
   }
+}
+
+TEST_CASE("Uuid tests - Binary uuid", "[uuid]")
+{
+  static_assert(std::is_trivially_copyable<flib::uuid_t>::value, "Binary uuid is not trivially copyable");
+  static_assert(16 == sizeof(flib::uuid_t), "Binary uuid size mismatch");
+  SECTION("String conversion")
+  {
+    auto uuid = flib::from_string("4EEEDB2F-BA0B-42B7-AE9F-EDA7A2EBE78C");
+    REQUIRE(0x4e == uuid.bytes[0]);
+    REQUIRE(0x8c == uuid.bytes[15]);
+    REQUIRE("4eeedb2f-ba0b-42b7-ae9f-eda7a2ebe78c" == flib::to_string(uuid));
+    REQUIRE(flib::test(uuid));
+    REQUIRE(!flib::test(flib::from_string("4eeedb2f-ba0b-32b7-ae9f-eda7a2ebe78c")));
+    REQUIRE(!flib::test(flib::from_string("4eeedb2f-ba0b-42b7-ce9f-eda7a2ebe78c")));
+    REQUIRE_THROWS_AS(flib::from_string("4eeedb2f-ba0b-42b7-ae9f-eda7a2ebe78"), std::runtime_error);
+    REQUIRE_THROWS_AS(flib::from_string("4eeedb2f-ba0b-42b7-ae9f+eda7a2ebe78c"), std::runtime_error);
+    REQUIRE_THROWS_AS(flib::from_string("4eeedb2f-ba0b-42b7-ae9f-eda7a2ebe78g"), std::runtime_error);
+  }
+  SECTION("Comparison and hashing")
+  {
+    std::vector<flib::uuid_t> uuids(1000);
+    std::unordered_set<flib::uuid_t> unique;
+    for (auto& uuid : uuids)
+    {
+      flib::generate(uuid);
+      REQUIRE(flib::test(uuid));
+      REQUIRE(::check_uuid_v4(flib::to_string(uuid)));
+      REQUIRE(uuid == flib::from_string(flib::to_string(uuid)));
+      unique.insert(uuid);
+    }
+    REQUIRE(uuids.size() == unique.size());
+    std::sort(uuids.begin(), uuids.end());
+    for (std::size_t i = 1; i < uuids.size(); ++i)
+    {
+      REQUIRE(uuids[i - 1] < uuids[i]);
+      REQUIRE(uuids[i - 1] != uuids[i]);
+      REQUIRE(flib::to_string(uuids[i - 1]) < flib::to_string(uuids[i]));
+    }
+    REQUIRE(std::hash<flib::uuid_t>()(uuids[0]) == std::hash<flib::uuid_t>()(flib::uuid_t(uuids[0])));
+  }
+}
+
+TEST_CASE("Uuid tests - Allocation-free formatting and parsing", "[uuid]")
+{
+  SECTION("Formatting")
+  {
+    for (auto i = 100; i > 0; --i)
+    {
+      flib::uuid_t uuid;
+      flib::generate(uuid);
+      char data[36];
+      flib::format_to(data, uuid);
+      REQUIRE(flib::to_string(uuid) == std::string(data, sizeof(data)));
+    }
+  }
+  SECTION("Parsing")
+  {
+    flib::uuid_t uuid;
+    REQUIRE(flib::parse("4EEEDB2F-BA0B-42B7-AE9F-EDA7A2EBE78C", uuid));
+    REQUIRE(flib::from_string("4eeedb2f-ba0b-42b7-ae9f-eda7a2ebe78c") == uuid);
+    REQUIRE(!flib::parse("4eeedb2f-ba0b-42b7-ae9f-eda7a2ebe78c", uuid, flib::version_t::v7));
+    REQUIRE(flib::parse("017f22e2-79b0-7cc3-98c4-dc0c0c07398f", uuid, flib::version_t::v7));
+    REQUIRE(flib::from_string("017f22e2-79b0-7cc3-98c4-dc0c0c07398f") == uuid);
+    // Every single character substitution must be accepted exactly when reference check accepts it
+    std::string text("a3c94bdd-8f3c-42b6-a84f-ce4932225064");
+    for (std::size_t position = 0; position < text.size(); ++position)
+    {
+      for (auto symbol = 1; symbol < 256; ++symbol)
+      {
+        auto mutated = text;
+        mutated[position] = static_cast<char>(symbol);
+        REQUIRE(::check_uuid_v4(mutated) == flib::parse(mutated.data(), uuid));
+        REQUIRE(::check_uuid_v4(mutated) == flib::test(mutated));
+      }
+    }
+  }
+  SECTION("Normalization")
+  {
+    flib::uuid_t uuid;
+    char data[] = "4EEEDB2F-BA0B-42B7-AE9F-EDA7A2EBE78C";
+    REQUIRE(flib::normalize(data, uuid));
+    REQUIRE(std::string("4eeedb2f-ba0b-42b7-ae9f-eda7a2ebe78c") == data);
+    REQUIRE(flib::from_string(data) == uuid);
+    char invalid[] = "4EEEDB2F-BA0B-42B7-AE9F-EDA7A2EBE78G";
+    REQUIRE(!flib::normalize(invalid, uuid));
+    REQUIRE(std::string("4EEEDB2F-BA0B-42B7-AE9F-EDA7A2EBE78G") == invalid);
+  }
+}
+
+TEST_CASE("Uuid tests - ULID form", "[uuid]")
+{
+  SECTION("Reference values")
+  {
+    auto uuid = flib::from_string("017f22e2-79b0-7cc3-98c4-dc0c0c07398f");
+    REQUIRE("01FWHE4YDGFK1SHH6W1G60EECF" == flib::to_ulid(uuid));
+    REQUIRE(uuid == flib::from_ulid("01FWHE4YDGFK1SHH6W1G60EECF"));
+    REQUIRE(uuid == flib::from_ulid("01fwhe4ydgfk1shh6w1g60eecf"));
+    REQUIRE(uuid == flib::from_ulid("o1FWHE4YDGFKiSHH6WLG6oEECF"));
+    REQUIRE("2EXVDJZEGB8AVTX7ZDMYHEQSWC" == flib::to_ulid(flib::from_string("4eeedb2f-ba0b-42b7-ae9f-eda7a2ebe78c")));
+    REQUIRE("00000000000000000000000000" == flib::to_ulid(flib::from_string("00000000-0000-0000-0000-000000000000")));
+    REQUIRE("7ZZZZZZZZZZZZZZZZZZZZZZZZZ" == flib::to_ulid(flib::from_string("ffffffff-ffff-ffff-ffff-ffffffffffff")));
+    REQUIRE_THROWS_AS(flib::from_ulid("8ZZZZZZZZZZZZZZZZZZZZZZZZZ"), std::runtime_error);
+    REQUIRE_THROWS_AS(flib::from_ulid("01FWHE4YDGFK1SHH6W1G60EEC"), std::runtime_error);
+    REQUIRE_THROWS_AS(flib::from_ulid("01FWHE4YDGFK1SHH6W1G60EECU"), std::runtime_error);
+  }
+  SECTION("Conversion cycle")
+  {
+    for (auto i = 1000; i > 0; --i)
+    {
+      flib::uuid_t uuid;
+      flib::generate(uuid, 0 == i % 2 ? flib::version_t::v4 : flib::version_t::v7);
+      char data[26];
+      flib::format_ulid_to(data, uuid);
+      REQUIRE(flib::to_ulid(uuid) == std::string(data, sizeof(data)));
+      flib::uuid_t result;
+      REQUIRE(flib::parse_ulid(data, result));
+      REQUIRE(uuid == result);
+    }
+  }
+  SECTION("Ordering")
+  {
+    std::vector<flib::uuid_t> uuids(1000);
+    for (std::size_t i = 0; i < uuids.size(); ++i)
+    {
+      flib::generate(uuids[i], 0 == i % 2 ? flib::version_t::v4 : flib::version_t::v7);
+    }
+    for (std::size_t i = 1; i < uuids.size(); ++i)
+    {
+      REQUIRE((uuids[i - 1] < uuids[i]) == (flib::to_ulid(uuids[i - 1]) < flib::to_ulid(uuids[i])));
+    }
+    std::vector<std::string> ulids;
+    for (auto i = 1000; i > 0; --i)
+    {
+      flib::uuid_t uuid;
+      flib::generate(uuid, flib::version_t::v7);
+      ulids.push_back(flib::to_ulid(uuid));
+    }
+    REQUIRE(std::is_sorted(ulids.begin(), ulids.end()));
+  }
+  SECTION("Validation")
+  {
+    // Every single character substitution must be accepted exactly when reference check accepts it
+    std::string text("01FWHE4YDGFK1SHH6W1G60EECF");
+    flib::uuid_t uuid;
+    for (std::size_t position = 0; position < text.size(); ++position)
+    {
+      for (auto symbol = 1; symbol < 256; ++symbol)
+      {
+        auto mutated = text;
+        mutated[position] = static_cast<char>(symbol);
+        REQUIRE(::check_ulid(mutated) == flib::parse_ulid(mutated.data(), uuid));
+      }
+    }
+  }
+}
+
+TEST_CASE("Uuid tests - Time-ordered uuid", "[uuid]")
+{
+  SECTION("Formatting and testing")
+  {
+    for (auto i = 10; i > 0; --i)
+    {
+      auto uuid = flib::generate(flib::version_t::v7);
+      REQUIRE(::check_uuid_v7(uuid));
+      REQUIRE(flib::test(uuid, flib::version_t::v7));
+      REQUIRE(!flib::test(uuid, flib::version_t::v4));
+      REQUIRE(!flib::test(flib::generate(), flib::version_t::v7));
+    }
+    REQUIRE(flib::test("017F22E2-79B0-7CC3-98C4-DC0C0C07398F", flib::version_t::v7));
+    REQUIRE(!flib::test("017f22e2-79b0-7cc3-c8c4-dc0c0c07398f", flib::version_t::v7));
+  }
+  SECTION("Monotonicity")
+  {
+    flib::uuid_t previous;
+    flib::generate(previous, flib::version_t::v7);
+    for (auto i = 100000; i > 0; --i)
+    {
+      flib::uuid_t uuid;
+      flib::generate(uuid, flib::version_t::v7);
+      REQUIRE(flib::test(uuid, flib::version_t::v7));
+      REQUIRE(previous < uuid);
+      previous = uuid;
+    }
+  }
+  SECTION("Time extraction")
+  {
+    auto start = std::chrono::system_clock::now() - std::chrono::milliseconds(1);
+    flib::uuid_t uuid;
+    flib::generate(uuid, flib::version_t::v7);
+    auto end = std::chrono::system_clock::now() + std::chrono::milliseconds(1);
+    REQUIRE(start <= flib::extract_time(uuid));
+    REQUIRE(flib::extract_time(uuid) <= end);
+    REQUIRE(std::chrono::system_clock::time_point(std::chrono::milliseconds(0x017f22e279b0)) ==
+      flib::extract_time(flib::from_string("017f22e2-79b0-7cc3-98c4-dc0c0c07398f")));
+  }
+}
+
+TEST_CASE("Uuid tests - Name-based uuid", "[uuid]")
+{
+  SECTION("Reference values")
+  {
+    flib::uuid_t uuid;
+    flib::generate(uuid, flib::namespace_dns, "www.example.com", flib::version_t::v3);
+    REQUIRE("5df41881-3aed-3515-88a7-2f4a814cf09e" == flib::to_string(uuid));
+    REQUIRE(flib::test(uuid, flib::version_t::v3));
+    flib::generate(uuid, flib::namespace_dns, "www.example.com");
+    REQUIRE("2ed6657d-e927-568b-95e1-2665a8aea6a2" == flib::to_string(uuid));
+    REQUIRE(flib::test(uuid, flib::version_t::v5));
+    // Name lengths around block and padding boundaries
+    for (const auto& reference : std::vector<std::pair<std::size_t, std::pair<std::string, std::string>>>{
+      { 0, { "14cdb9b4-de01-3faa-aff5-65bc2f771745", "1b4db7eb-4057-5ddf-91e0-36dec72071f5" } },
+      { 47, { "cd7dbfe4-968b-3de8-bb16-54a3ed2fc4c3", "60100e11-180f-59cb-911f-bdb3aa734c9d" } },
+      { 48, { "f372ec70-5bc5-33c4-abb9-17f2eb80fac9", "aa33c522-9edc-58a5-b5af-e2a12995886e" } },
+      { 55, { "bc5011fb-c5df-3b9c-a1bb-ddc76e64ee6b", "216292ab-33d5-55d9-9441-e27c6d581a9d" } },
+      { 100, { "12fd4b9c-db2b-3f99-a519-a67b82db2c06", "864949eb-2508-5b93-a1e7-0fe6ca888495" } },
+      { 1000, { "d8f8a14e-39ec-3186-8107-4d4e5a41d2c0", "7f46a8f9-f8ba-5a67-983a-ffc2101475df" } }
+      })
+    {
+      std::string name(reference.first, 'a');
+      flib::generate(uuid, flib::namespace_url, name, flib::version_t::v3);
+      REQUIRE(reference.second.first == flib::to_string(uuid));
+      flib::generate(uuid, flib::namespace_url, name.data(), name.size(), flib::version_t::v5);
+      REQUIRE(reference.second.second == flib::to_string(uuid));
+    }
+  }
+  SECTION("Batch generation")
+  {
+    std::vector<std::string> names;
+    for (auto i = 0; i < 1000; ++i)
+    {
+      names.push_back("name-" + std::to_string(i));
+    }
+    std::vector<flib::uuid_t> uuids(names.size());
+    flib::generate_n(uuids.data(), flib::namespace_oid, names.data(), names.size());
+    std::unordered_set<flib::uuid_t> unique(uuids.begin(), uuids.end());
+    REQUIRE(names.size() == unique.size());
+    for (std::size_t i = 0; i < names.size(); ++i)
+    {
+      flib::uuid_t uuid;
+      flib::generate(uuid, flib::namespace_oid, names[i]);
+      REQUIRE(uuid == uuids[i]);
+      REQUIRE(flib::test(uuid, flib::version_t::v5));
+      flib::generate(uuid, flib::namespace_x500, names[i]);
+      REQUIRE(uuid != uuids[i]);
+    }
+  }
+}
+
+TEST_CASE("Uuid tests - Multithreaded generation", "[uuid]")
+{
+  std::vector<std::vector<flib::uuid_t>> uuids(4, std::vector<flib::uuid_t>(10000));
+  std::vector<std::thread> threads;
+  for (auto& thread_uuids : uuids)
+  {
+    threads.emplace_back([&thread_uuids]
+      {
+        for (auto& uuid : thread_uuids)
+        {
+          flib::generate(uuid);
+        }
+      });
+  }
+  std::unordered_set<flib::uuid_t> unique;
+  for (std::size_t i = 0; i < threads.size(); ++i)
+  {
+    threads[i].join();
+    for (auto& uuid : uuids[i])
+    {
+      REQUIRE(flib::test(uuid));
+      unique.insert(uuid);
+    }
+  }
+  REQUIRE(40000 == unique.size());
+}
+
+TEST_CASE("Uuid tests - Generator backends", "[uuid]")
+{
+  SECTION("Per-thread generators")
+  {
+    for (auto i = 10; i > 0; --i)
+    {
+      REQUIRE(::check_uuid_v4(flib::generate<flib::wyrand>()));
+      REQUIRE(::check_uuid_v4(flib::generate<std::mt19937_64>()));
+      REQUIRE(::check_uuid_v4(flib::generate<std::mt19937>()));
+      REQUIRE(::check_uuid_v4(flib::generate<flib::secure_generator>()));
+      REQUIRE(::check_uuid_v7(flib::generate<flib::wyrand>(flib::version_t::v7)));
+    }
+  }
+  SECTION("Caller generator")
+  {
+    flib::xoshiro256ss generator_1(42);
+    flib::xoshiro256ss generator_2(42);
+    flib::uuid_t uuid_1;
+    flib::uuid_t uuid_2;
+    for (auto i = 10; i > 0; --i)
+    {
+      flib::generate(uuid_1, generator_1);
+      flib::generate(uuid_2, generator_2);
+      REQUIRE(flib::test(uuid_1));
+      REQUIRE(uuid_1 == uuid_2);
+    }
+    flib::generate(uuid_1, generator_1, flib::version_t::v7);
+    flib::generate(uuid_2, generator_2, flib::version_t::v7);
+    REQUIRE(flib::test(uuid_1, flib::version_t::v7));
+    REQUIRE(uuid_1 < uuid_2);
+  }
+}
+
+TEST_CASE("Uuid tests - Bulk generation", "[uuid]")
+{
+  for (auto version : { flib::version_t::v4, flib::version_t::v7 })
+  {
+    SECTION("Binary v" + std::to_string(static_cast<int>(version)))
+    {
+      std::vector<flib::uuid_t> uuids(1000);
+      flib::generate_n(uuids.data(), uuids.size(), version);
+      std::unordered_set<flib::uuid_t> unique(uuids.begin(), uuids.end());
+      REQUIRE(uuids.size() == unique.size());
+      for (std::size_t i = 0; i < uuids.size(); ++i)
+      {
+        REQUIRE(flib::test(uuids[i], version));
+        REQUIRE((flib::version_t::v4 == version || 0 == i || uuids[i - 1] < uuids[i]));
+      }
+    }
+    SECTION("String v" + std::to_string(static_cast<int>(version)))
+    {
+      std::string text(36 * 1000 + 1, '#');
+      flib::generate_n(&text[0], 1000, version);
+      REQUIRE('#' == text.back());
+      std::unordered_set<std::string> unique;
+      for (std::size_t i = 0; i < 1000; ++i)
+      {
+        auto uuid = text.substr(36 * i, 36);
+        REQUIRE((flib::version_t::v4 == version ? ::check_uuid_v4(uuid) : ::check_uuid_v7(uuid)));
+        REQUIRE(uuid == flib::to_string(flib::from_string(uuid)));
+        unique.insert(uuid);
+      }
+      REQUIRE(1000 == unique.size());
+    }
+  }
+  SECTION("Name-based versions")
+  {
+    // Name-based versions require name, so they are rejected instead of substituted
+    for (auto version : { flib::version_t::v3, flib::version_t::v5 })
+    {
+      std::vector<flib::uuid_t> uuids(100);
+      std::string text(36 * 100, '#');
+      REQUIRE_THROWS_AS(flib::generate_n(uuids.data(), uuids.size(), version), std::invalid_argument);
+      REQUIRE_THROWS_AS(flib::generate_n(&text[0], 100, version), std::invalid_argument);
+      REQUIRE_THROWS_AS(flib::generate(uuids[0], version), std::invalid_argument);
+      REQUIRE_THROWS_AS(flib::generate(version), std::invalid_argument);
+      REQUIRE_THROWS_AS(flib::generate<flib::wyrand>(uuids[0], version), std::invalid_argument);
+    }
+  }
+  SECTION("Empty range")
+  {
+    flib::generate_n(static_cast<flib::uuid_t*>(nullptr), 0);
+    flib::generate_n(static_cast<char*>(nullptr), 0);
+  }
+}
+
+TEST_CASE("Uuid tests - Benchmarks", "[uuid][.benchmark]")
+{
+  auto text = flib::generate();
+  auto uuid = flib::from_string(text);
+  BENCHMARK("generate (string)")
+  {
+    return flib::generate();
+  };
+  BENCHMARK("generate (binary)")
+  {
+    flib::generate(uuid);
+    return uuid;
+  };
+  BENCHMARK("generate<std::mt19937_64> (binary)")
+  {
+    flib::generate<std::mt19937_64>(uuid);
+    return uuid;
+  };
+  BENCHMARK("generate<flib::wyrand> (binary)")
+  {
+    flib::generate<flib::wyrand>(uuid);
+    return uuid;
+  };
+  BENCHMARK("generate<flib::secure_generator> (binary)")
+  {
+    flib::generate<flib::secure_generator>(uuid);
+    return uuid;
+  };
+  BENCHMARK("generate (binary v7)")
+  {
+    flib::generate(uuid, flib::version_t::v7);
+    return uuid;
+  };
+  BENCHMARK("generate (string) x1000")
+  {
+    std::vector<std::string> uuids;
+    uuids.reserve(1000);
+    for (auto i = 1000; i > 0; --i)
+    {
+      uuids.push_back(flib::generate());
+    }
+    return uuids;
+  };
+  std::vector<flib::uuid_t> uuids(1000);
+  std::string buffer(36 * 1000, '-');
+  BENCHMARK("generate (binary) x1000")
+  {
+    for (auto& item : uuids)
+    {
+      flib::generate(item);
+    }
+    return uuids.data();
+  };
+  BENCHMARK("generate_n (binary) x1000")
+  {
+    flib::generate_n(uuids.data(), uuids.size());
+    return uuids.data();
+  };
+  BENCHMARK("generate_n (string) x1000")
+  {
+    flib::generate_n(&buffer[0], 1000);
+    return buffer.data();
+  };
+  BENCHMARK("to_string")
+  {
+    return flib::to_string(uuid);
+  };
+  BENCHMARK("format_to")
+  {
+    char data[36];
+    flib::format_to(data, uuid);
+    return data[0];
+  };
+  BENCHMARK("test (string)")
+  {
+    return flib::test(text);
+  };
+  BENCHMARK("from_string")
+  {
+    return flib::from_string(text);
+  };
+  BENCHMARK("parse")
+  {
+    flib::uuid_t result;
+    return flib::parse(text.data(), result);
+  };
+  auto upper = text;
+  std::transform(upper.begin(), upper.end(), upper.begin(), [](char symbol)
+    {
+      return static_cast<char>(std::toupper(symbol));
+    });
+  BENCHMARK("normalize")
+  {
+    auto data = upper;
+    flib::uuid_t result;
+    return flib::normalize(&data[0], result);
+  };
+  BENCHMARK("to_ulid")
+  {
+    return flib::to_ulid(uuid);
+  };
+  BENCHMARK("format_ulid_to")
+  {
+    char data[26];
+    flib::format_ulid_to(data, uuid);
+    return data[0];
+  };
+  auto ulid = flib::to_ulid(uuid);
+  BENCHMARK("parse_ulid")
+  {
+    flib::uuid_t result;
+    return flib::parse_ulid(ulid.data(), result);
+  };
+  std::string name("https://www.example.com/some/resource/path");
+  BENCHMARK("generate (v3)")
+  {
+    flib::generate(uuid, flib::namespace_url, name, flib::version_t::v3);
+    return uuid;
+  };
+  BENCHMARK("generate (v5)")
+  {
+    flib::generate(uuid, flib::namespace_url, name);
+    return uuid;
+  };
+  BENCHMARK("std::hash (string)")
+  {
+    return std::hash<std::string>()(text);
+  };
+  BENCHMARK("std::hash (binary)")
+  {
+    return std::hash<flib::uuid_t>()(uuid);
+  };
+  for (auto thread_count : { 1u, 2u, 4u })
+  {
+    BENCHMARK("generate (binary) x10000 on " + std::to_string(thread_count) + " threads")
+    {
+      std::vector<std::thread> threads;
+      for (auto i = thread_count; i > 0; --i)
+      {
+        threads.emplace_back([]
+          {
+            flib::uuid_t thread_uuid;
+            for (auto j = 10000; j > 0; --j)
+            {
+              flib::generate(thread_uuid);
+            }
+          });
+      }
+      for (auto& thread : threads)
+      {
+        thread.join();
+      }
+      return threads.size();
+    };
+  }
+}
+
+TEST_CASE("Uuid tests - Secure generator overhead", "[uuid][.benchmark]")
+{
+  // Secure generation (buffered ChaCha20 keystream) stays within fixed multiple of default generation with small-state
+  // generator
+  auto default_duration = ::shortest_generation([](flib::uuid_t& uuid)
+    {
+      flib::generate(uuid);
+    });
+  auto secure_duration = ::shortest_generation([](flib::uuid_t& uuid)
+    {
+      flib::generate<flib::secure_generator>(uuid);
+    });
+  INFO("default: " << default_duration.count() << " ns, secure: " << secure_duration.count() << " ns");
+  REQUIRE(secure_duration < 12 * default_duration);
 }
\ No newline at end of file